@@ -0,0 +1,115 @@
+#!/usr/bin/env python
+#
+# Copyright Contributors to the OpenTimelineIO project
+#
+# Licensed under the Apache License, Version 2.0 (the "Apache License")
+# with the following modification; you may not use this file except in
+# compliance with the Apache License and the following modification to it:
+# Section 6. Trademarks. is deleted and replaced with:
+#
+# 6. Trademarks. This License does not grant permission to use the trade
+#    names, trademarks, service marks, or product names of the Licensor
+#    and its affiliates, except as required to comply with Section 4(c) of
+#    the License and to reproduce the content of the NOTICE file.
+#
+# You may obtain a copy of the Apache License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the Apache License with the above modification is
+# distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied. See the Apache License for the specific
+# language governing permissions and limitations under the Apache License.
+#
+
+
+"""Example OTIO script that reports how much memory each Clip of a timeline
+takes once it has been read in.
+
+Reads the JSON encoding of a track of plain clips over and over, keeping
+every copy, and divides the growth in the process's resident memory by the
+number of clips read.  (Reading a track at a time lets each read reuse the
+memory the previous one needed only while parsing.)
+
+Demo:
+
+% clip_memory.py -n 200000
+Read 200000 clips: 486.9 bytes per clip.
+
+"""
+
+import argparse
+import os
+import resource
+import sys
+
+import opentimelineio as otio
+
+CLIPS_PER_TRACK = 1000
+
+
+def parse_args():
+    """ parse arguments out of sys.argv """
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        '-n',
+        '--clips',
+        type=int,
+        default=200000,
+        help='Number of clips to read.'
+    )
+    return parser.parse_args()
+
+
+def resident_bytes():
+    """ the resident memory of this process, in bytes """
+    try:
+        with open("/proc/self/statm") as statm:
+            return int(statm.read().split()[1]) * os.sysconf("SC_PAGE_SIZE")
+    except (IOError, OSError):
+        # Without /proc, fall back on the peak, which is as good here since
+        # memory only grows while the clips are read.
+        peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+        return peak if sys.platform == "darwin" else peak * 1024
+
+
+def encoded_track(clip_count):
+    """ a JSON string holding a track of clip_count clips """
+    clip = otio.schema.Clip(
+        name="clip",
+        source_range=otio.opentime.TimeRange(
+            otio.opentime.RationalTime(0, 24),
+            otio.opentime.RationalTime(24, 24)
+        )
+    )
+    encoded_clip = otio.adapters.otio_json.write_to_string(clip, indent=-1)
+
+    track = otio.schema.Track(name="track")
+    encoded_track = otio.adapters.otio_json.write_to_string(track, indent=-1)
+    children = '"children":[]'
+    return encoded_track.replace(
+        children,
+        '"children":[{}]'.format(",".join([encoded_clip] * clip_count))
+    )
+
+
+def main():
+    args = parse_args()
+
+    encoded = encoded_track(CLIPS_PER_TRACK)
+    otio.adapters.otio_json.read_from_string(encoded)
+
+    tracks = []
+    before = resident_bytes()
+    while len(tracks) * CLIPS_PER_TRACK < args.clips:
+        tracks.append(otio.adapters.otio_json.read_from_string(encoded))
+    after = resident_bytes()
+
+    clip_count = sum(len(track) for track in tracks)
+    print("Read {} clips: {:.1f} bytes per clip.".format(
+        clip_count, float(after - before) / clip_count))
+
+
+if __name__ == '__main__':
+    main()
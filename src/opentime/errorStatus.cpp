@@ -20,6 +20,8 @@ std::string ErrorStatus::outcome_to_string(Outcome o) {
         return "value cannot be negative here";
     case INVALID_RATE_FOR_DROP_FRAME_TIMECODE:
         return "rate is not valid for drop frame timecode";
+    case INEXACT_TIME:
+        return "time has no exact equivalent";
     default:
         return "unknown/illegal ErrorStatus::Outcome code";
     };
@@ -0,0 +1,147 @@
+#include "opentime/exactTime.h"
+#include "opentime/stringPrintf.h"
+#include <cmath>
+
+namespace opentime { namespace OPENTIME_VERSION  {
+
+constexpr double ExactTime::_invalid_rate;
+
+static bool _multiply(int64_t a, int64_t factor, int64_t* product) {
+    // factor is always positive here
+    if (a > std::numeric_limits<int64_t>::max() / factor ||
+        a < std::numeric_limits<int64_t>::min() / factor) {
+        return false;
+    }
+    *product = a * factor;
+    return true;
+}
+
+// The 128 bit product of a and b, as high and low halves.
+static void _multiply_wide(uint64_t a, uint64_t b, uint64_t* high, uint64_t* low) {
+    uint64_t a_low = a & 0xffffffff, a_high = a >> 32;
+    uint64_t b_low = b & 0xffffffff, b_high = b >> 32;
+
+    uint64_t low_low = a_low * b_low;
+    uint64_t high_low = a_high * b_low;
+    uint64_t low_high = a_low * b_high;
+    uint64_t middle = (low_low >> 32) + (high_low & 0xffffffff) + (low_high & 0xffffffff);
+
+    *low = (middle << 32) | (low_low & 0xffffffff);
+    *high = a_high * b_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32);
+}
+
+static uint64_t _magnitude(int64_t value) {
+    return value < 0 ? uint64_t(-(value + 1)) + 1 : uint64_t(value);
+}
+
+ExactTime ExactTime::_add_across_rates(ExactTime lhs, ExactTime rhs) {
+    if (lhs.is_invalid_time() || rhs.is_invalid_time()) {
+        return _invalid_time();
+    }
+
+    // the finest rate both are whole numbers of ticks at is the least common
+    // multiple of the numerators over the greatest common divisor of the
+    // denominators, which is in lowest terms already
+    int64_t denominator = _gcd(lhs._rate_denominator, rhs._rate_denominator);
+    int64_t numerator = int64_t(lhs._rate_numerator / _gcd(lhs._rate_numerator, rhs._rate_numerator)) *
+                        rhs._rate_numerator;
+    if (numerator > std::numeric_limits<int32_t>::max()) {
+        return _invalid_time();
+    }
+
+    int64_t lhs_value, rhs_value, sum;
+    if (!_multiply(lhs._value, (lhs._rate_denominator / denominator) * (numerator / lhs._rate_numerator),
+                   &lhs_value) ||
+        !_multiply(rhs._value, (rhs._rate_denominator / denominator) * (numerator / rhs._rate_numerator),
+                   &rhs_value) ||
+        !_add(lhs_value, rhs_value, &sum)) {
+        return _invalid_time();
+    }
+    return ExactTime {sum, int32_t(numerator), int32_t(denominator)};
+}
+
+int ExactTime::_compare_across_rates(ExactTime lhs, ExactTime rhs) {
+    // compares lhs.value * lhs.denominator / lhs.numerator with the same for
+    // rhs, by multiplying both out in 128 bits
+    int lhs_sign = (lhs._value > 0) - (lhs._value < 0);
+    int rhs_sign = (rhs._value > 0) - (rhs._value < 0);
+    if (lhs_sign != rhs_sign || lhs_sign == 0) {
+        return lhs_sign < rhs_sign ? -1 : (lhs_sign > rhs_sign ? 1 : 0);
+    }
+
+    uint64_t lhs_high, lhs_low, rhs_high, rhs_low;
+    _multiply_wide(_magnitude(lhs._value), uint64_t(lhs._rate_denominator) * uint64_t(rhs._rate_numerator),
+                   &lhs_high, &lhs_low);
+    _multiply_wide(_magnitude(rhs._value), uint64_t(rhs._rate_denominator) * uint64_t(lhs._rate_numerator),
+                   &rhs_high, &rhs_low);
+
+    int order = lhs_high != rhs_high ? (lhs_high < rhs_high ? -1 : 1)
+                                     : (lhs_low < rhs_low ? -1 : (lhs_low > rhs_low ? 1 : 0));
+    return lhs_sign < 0 ? -order : order;
+}
+
+/*
+ * The first convergent of the continued fraction for x (which isn't negative)
+ * that converts back to x exactly, if that happens before the numerator or
+ * denominator would exceed the limits given.
+ */
+static bool _exact_fraction(double x, int64_t max_numerator, int64_t max_denominator,
+                            int64_t* numerator, int64_t* denominator) {
+    int64_t previous_numerator = 0, previous_denominator = 1;
+    int64_t current_numerator = 1, current_denominator = 0;
+    double remainder = x;
+
+    for (int i = 0; i < 64; i++) {
+        double whole = floor(remainder);
+        if (!(whole < double(max_numerator))) {
+            return false;
+        }
+
+        int64_t term = int64_t(whole);
+        if ((current_numerator && term > (max_numerator - previous_numerator) / current_numerator) ||
+            (current_denominator && term > (max_denominator - previous_denominator) / current_denominator)) {
+            return false;
+        }
+
+        int64_t next_numerator = term * current_numerator + previous_numerator;
+        int64_t next_denominator = term * current_denominator + previous_denominator;
+        if (double(next_numerator) / double(next_denominator) == x) {
+            *numerator = next_numerator;
+            *denominator = next_denominator;
+            return true;
+        }
+
+        double fraction = remainder - whole;
+        if (fraction <= 0) {
+            return false;
+        }
+
+        remainder = 1 / fraction;
+        previous_numerator = current_numerator;
+        previous_denominator = current_denominator;
+        current_numerator = next_numerator;
+        current_denominator = next_denominator;
+    }
+    return false;
+}
+
+ExactTime ExactTime::from_rational_time(RationalTime time, ErrorStatus* error_status) {
+    int64_t rate_numerator, rate_denominator, value_numerator, value_denominator;
+    int64_t const max_rate_term = std::numeric_limits<int32_t>::max();
+
+    // the value's denominator multiplies the rate, so it's limited by it
+    if (time.is_invalid_time() || !std::isfinite(time.rate()) ||
+        !_exact_fraction(time.rate(), max_rate_term, max_rate_term, &rate_numerator, &rate_denominator) ||
+        !_exact_fraction(fabs(time.value()), std::numeric_limits<int64_t>::max(),
+                         max_rate_term / rate_numerator, &value_numerator, &value_denominator)) {
+        *error_status = ErrorStatus(ErrorStatus::INEXACT_TIME,
+                                    string_printf("%g at a rate of %g has no exact equivalent",
+                                                  time.value(), time.rate()));
+        return _invalid_time();
+    }
+
+    return ExactTime {time.value() < 0 ? -value_numerator : value_numerator,
+                      int32_t(rate_numerator * value_denominator), int32_t(rate_denominator)};
+}
+
+} }
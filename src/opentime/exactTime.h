@@ -0,0 +1,176 @@
+#pragma once
+
+#include "opentime/version.h"
+#include "opentime/errorStatus.h"
+#include "opentime/rationalTime.h"
+#include <cstdint>
+#include <limits>
+
+namespace opentime { namespace OPENTIME_VERSION  {
+
+/**
+ * An exact alternative to RationalTime: a whole number of ticks at a rate
+ * that is a ratio of whole numbers, such as 24000/1001.  Arithmetic and
+ * comparison involve no rounding, so long sums don't drift and equal times
+ * compare equal without needing an epsilon.  Times at the same rate are
+ * added and compared directly; across rates the result is at the finest
+ * rate both can be written at exactly.
+ *
+ * Rates are kept in lowest terms.  A rate that isn't positive, or a result
+ * that wouldn't fit, gives an invalid time, which later arithmetic passes on
+ * as NaN does for RationalTime.
+ */
+class ExactTime {
+public:
+    explicit ExactTime(int64_t value = 0, int32_t rate_numerator = 1, int32_t rate_denominator = 1)
+    : _value {value}, _rate_numerator {rate_numerator}, _rate_denominator {rate_denominator} {
+        if (_rate_denominator < 0) {
+            bool negatable = (_rate_numerator != std::numeric_limits<int32_t>::min() &&
+                              _rate_denominator != std::numeric_limits<int32_t>::min());
+            _rate_numerator = negatable ? -_rate_numerator : 0;
+            _rate_denominator = negatable ? -_rate_denominator : 1;
+        }
+
+        int32_t divisor = _gcd(_rate_numerator, _rate_denominator);
+        if (divisor > 1) {
+            _rate_numerator /= divisor;
+            _rate_denominator /= divisor;
+        }
+    }
+
+    ExactTime(ExactTime const&) = default;
+    ExactTime& operator= (ExactTime const&) = default;
+
+    bool is_invalid_time() const {
+        return _rate_numerator <= 0 || _rate_denominator <= 0;
+    }
+
+    int64_t value() const {
+        return _value;
+    }
+
+    int32_t rate_numerator() const {
+        return _rate_numerator;
+    }
+
+    int32_t rate_denominator() const {
+        return _rate_denominator;
+    }
+
+    double rate() const {
+        return is_invalid_time() ? _invalid_rate : double(_rate_numerator) / _rate_denominator;
+    }
+
+    double to_seconds() const {
+        return double(_value) * _rate_denominator / _rate_numerator;
+    }
+
+    RationalTime to_rational_time() const {
+        return RationalTime {double(_value), rate()};
+    }
+
+    /**
+     * The exact equivalent of time, if there is one.  The rate is taken to be
+     * exactly the ratio closest to it that converts back to the same double,
+     * so 30000.0/1001.0 becomes 30000/1001, but 23.976 becomes 2997/125, not
+     * 24000/1001.  A value with a fractional part moves the time to a finer
+     * rate that makes it whole.
+     */
+    static ExactTime from_rational_time(RationalTime time, ErrorStatus *error_status);
+
+    ExactTime const& operator+= (ExactTime other) {
+        return *this = *this + other;
+    }
+
+    ExactTime const& operator-= (ExactTime other) {
+        return *this = *this - other;
+    }
+
+    friend ExactTime operator+ (ExactTime lhs, ExactTime rhs) {
+        if (lhs._same_rate(rhs)) {
+            int64_t sum;
+            return _add(lhs._value, rhs._value, &sum) ? lhs._with_value(sum) : _invalid_time();
+        }
+        return _add_across_rates(lhs, rhs);
+    }
+
+    friend ExactTime operator- (ExactTime lhs, ExactTime rhs) {
+        return lhs + -rhs;
+    }
+
+    friend ExactTime operator- (ExactTime lhs) {
+        return lhs._value == std::numeric_limits<int64_t>::min() ?
+            _invalid_time() : lhs._with_value(-lhs._value);
+    }
+
+    friend bool operator> (ExactTime lhs, ExactTime rhs) {
+        return lhs._same_rate(rhs) ? lhs._value > rhs._value : _compare_across_rates(lhs, rhs) > 0;
+    }
+
+    friend bool operator>= (ExactTime lhs, ExactTime rhs) {
+        return lhs._same_rate(rhs) ? lhs._value >= rhs._value : _compare_across_rates(lhs, rhs) >= 0;
+    }
+
+    friend bool operator< (ExactTime lhs, ExactTime rhs) {
+        return lhs._same_rate(rhs) ? lhs._value < rhs._value : _compare_across_rates(lhs, rhs) < 0;
+    }
+
+    friend bool operator<= (ExactTime lhs, ExactTime rhs) {
+        return lhs._same_rate(rhs) ? lhs._value <= rhs._value : _compare_across_rates(lhs, rhs) <= 0;
+    }
+
+    friend bool operator== (ExactTime lhs, ExactTime rhs) {
+        return lhs._same_rate(rhs) ? lhs._value == rhs._value : _compare_across_rates(lhs, rhs) == 0;
+    }
+
+    friend bool operator!= (ExactTime lhs, ExactTime rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    static constexpr double _invalid_rate = -1;
+
+    static ExactTime _invalid_time() {
+        return ExactTime {0, 0, 1};
+    }
+
+    // The same rate, which is already in lowest terms.
+    ExactTime _with_value(int64_t value) const {
+        ExactTime result = *this;
+        result._value = value;
+        return result;
+    }
+
+    static int32_t _gcd(int32_t a, int32_t b) {
+        // negated rather than made positive, so that INT32_MIN can't overflow
+        a = a > 0 ? -a : a;
+        b = b > 0 ? -b : b;
+        while (b != 0) {
+            int32_t r = a % b;
+            a = b;
+            b = r;
+        }
+        return a == std::numeric_limits<int32_t>::min() ? 1 : -a;
+    }
+
+    static bool _add(int64_t a, int64_t b, int64_t* sum) {
+        // wraps around rather than overflowing, which it did if the sign of
+        // the result differs from the signs of both a and b
+        *sum = int64_t(uint64_t(a) + uint64_t(b));
+        return ((a ^ *sum) & (b ^ *sum)) >= 0;
+    }
+
+    bool _same_rate(ExactTime other) const {
+        return ((_rate_numerator ^ other._rate_numerator) | (_rate_denominator ^ other._rate_denominator)) == 0;
+    }
+
+    static ExactTime _add_across_rates(ExactTime lhs, ExactTime rhs);
+    static int _compare_across_rates(ExactTime lhs, ExactTime rhs);
+
+    friend class ExactTimeRange;
+
+    int64_t _value;
+    int32_t _rate_numerator, _rate_denominator;
+};
+
+} }
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "opentime/version.h"
+#include "opentime/exactTime.h"
+#include "opentime/timeRange.h"
+
+namespace opentime { namespace OPENTIME_VERSION  {
+
+/**
+ * The exact counterpart of TimeRange, over ExactTime.  The predicates are
+ * those of TimeRange, but with no epsilon: times that differ at all are
+ * different, which is what TimeRange's default epsilon_s approximates.
+ * As with TimeRange, they are written for positive durations.
+ */
+class ExactTimeRange {
+public:
+    explicit ExactTimeRange() : _start_time{}, _duration{} {}
+
+    explicit ExactTimeRange(ExactTime start_time)
+            : _start_time{start_time},
+              _duration{ExactTime{0, start_time.rate_numerator(), start_time.rate_denominator()}} {}
+
+    explicit ExactTimeRange(ExactTime start_time, ExactTime duration)
+            : _start_time{start_time}, _duration{duration} {}
+
+    ExactTimeRange(ExactTimeRange const &) = default;
+
+    ExactTimeRange &operator=(ExactTimeRange const &) = default;
+
+    ExactTime const &start_time() const {
+        return _start_time;
+    }
+
+    ExactTime const &duration() const {
+        return _duration;
+    }
+
+    ExactTime end_time_exclusive() const {
+        return _start_time + _duration;
+    }
+
+    TimeRange to_time_range() const {
+        return TimeRange{_start_time.to_rational_time(), _duration.to_rational_time()};
+    }
+
+    // The exact equivalent of range, if both its times have one.
+    static ExactTimeRange from_time_range(TimeRange range, ErrorStatus *error_status) {
+        ExactTime start_time = ExactTime::from_rational_time(range.start_time(), error_status);
+        if (*error_status) {
+            return ExactTimeRange{};
+        }
+        return ExactTimeRange{start_time, ExactTime::from_rational_time(range.duration(), error_status)};
+    }
+
+    /**
+     * <b>other</b> is at or after the start of <b>this</b>, and before its end.
+     */
+    bool contains(ExactTime other) const {
+        return _start_time <= other && other < end_time_exclusive();
+    }
+
+    /**
+     * The start of <b>this</b> precedes the start of <b>other</b>, and the
+     * end of <b>other</b> precedes the end of <b>this</b>.
+     */
+    bool contains(ExactTimeRange other) const {
+        int64_t end, other_end;
+        if (_at_one_rate(other, &end, &other_end)) {
+            return _start_time.value() < other._start_time.value() && other_end < end;
+        }
+        return _start_time < other._start_time && other.end_time_exclusive() < end_time_exclusive();
+    }
+
+    bool overlaps(ExactTime other) const {
+        return contains(other);
+    }
+
+    /**
+     * The start of <b>this</b> precedes the start of <b>other</b>, which
+     * precedes the end of <b>this</b>, which precedes the end of <b>other</b>.
+     */
+    bool overlaps(ExactTimeRange other) const {
+        int64_t end_value, other_end;
+        if (_at_one_rate(other, &end_value, &other_end)) {
+            return _start_time.value() < other._start_time.value() && other._start_time.value() < end_value &&
+                   end_value < other_end;
+        }
+
+        ExactTime end = end_time_exclusive();
+        return _start_time < other._start_time && other._start_time < end &&
+               end < other.end_time_exclusive();
+    }
+
+    /**
+     * The end of <b>this</b> precedes the start of <b>other</b>.
+     */
+    bool before(ExactTimeRange other) const {
+        int64_t end, other_end;
+        if (_at_one_rate(other, &end, &other_end)) {
+            return end < other._start_time.value();
+        }
+        return end_time_exclusive() < other._start_time;
+    }
+
+    /**
+     * The end of <b>this</b> precedes <b>other</b>.
+     */
+    bool before(ExactTime other) const {
+        return end_time_exclusive() < other;
+    }
+
+    /**
+     * The end of <b>this</b> is the start of <b>other</b>.
+     */
+    bool meets(ExactTimeRange other) const {
+        int64_t end, other_end;
+        if (_at_one_rate(other, &end, &other_end)) {
+            return end == other._start_time.value();
+        }
+        return end_time_exclusive() == other._start_time;
+    }
+
+    /**
+     * The starts are the same, and the end of <b>this</b> precedes the end
+     * of <b>other</b>.
+     */
+    bool begins(ExactTimeRange other) const {
+        int64_t end, other_end;
+        if (_at_one_rate(other, &end, &other_end)) {
+            return _start_time.value() == other._start_time.value() && end < other_end;
+        }
+        return _start_time == other._start_time && end_time_exclusive() < other.end_time_exclusive();
+    }
+
+    /**
+     * The start of <b>this</b> is <b>other</b>.
+     */
+    bool begins(ExactTime other) const {
+        return _start_time == other;
+    }
+
+    /**
+     * The ends are the same, and the start of <b>other</b> precedes the
+     * start of <b>this</b>.
+     */
+    bool finishes(ExactTimeRange other) const {
+        int64_t end, other_end;
+        if (_at_one_rate(other, &end, &other_end)) {
+            return end == other_end && other._start_time.value() < _start_time.value();
+        }
+        return end_time_exclusive() == other.end_time_exclusive() && other._start_time < _start_time;
+    }
+
+    /**
+     * The end of <b>this</b> is <b>other</b>.
+     */
+    bool finishes(ExactTime other) const {
+        return end_time_exclusive() == other;
+    }
+
+    /**
+     * <b>this</b> and <b>other</b> have some time in common.
+     */
+    bool intersects(ExactTimeRange other) const {
+        int64_t end, other_end;
+        if (_at_one_rate(other, &end, &other_end)) {
+            return _start_time.value() < other_end && other._start_time.value() < end;
+        }
+        return _start_time < other.end_time_exclusive() && other._start_time < end_time_exclusive();
+    }
+
+    friend bool operator==(ExactTimeRange lhs, ExactTimeRange rhs) {
+        return lhs._start_time == rhs._start_time && lhs._duration == rhs._duration;
+    }
+
+    friend bool operator!=(ExactTimeRange lhs, ExactTimeRange rhs) {
+        return !(lhs == rhs);
+    }
+
+    static ExactTimeRange range_from_start_end_time(ExactTime start_time, ExactTime end_time_exclusive) {
+        return ExactTimeRange{start_time, end_time_exclusive - start_time};
+    }
+
+private:
+    ExactTime _start_time, _duration;
+
+    /**
+     * Whether both ranges are entirely at one rate, in which case the
+     * predicates compare tick counts directly, using the ends given here.
+     */
+    bool _at_one_rate(ExactTimeRange other, int64_t* end, int64_t* other_end) const {
+        // the rates are compared all together, which saves branching on each
+        int32_t numerator = _start_time._rate_numerator, denominator = _start_time._rate_denominator;
+        int32_t differences = (numerator ^ _duration._rate_numerator) |
+                              (numerator ^ other._start_time._rate_numerator) |
+                              (numerator ^ other._duration._rate_numerator) |
+                              (denominator ^ _duration._rate_denominator) |
+                              (denominator ^ other._start_time._rate_denominator) |
+                              (denominator ^ other._duration._rate_denominator);
+        bool end_fits = ExactTime::_add(_start_time._value, _duration._value, end);
+        bool other_end_fits = ExactTime::_add(other._start_time._value, other._duration._value, other_end);
+        return (differences == 0) & end_fits & other_end_fits;
+    }
+};
+
+} }
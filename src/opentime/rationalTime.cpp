@@ -1,8 +1,8 @@
 #include "opentime/rationalTime.h"
 #include "opentime/stringPrintf.h"
-#include <array>
 #include <algorithm>
 #include <ciso646>
+#include <cctype>
 #include <cmath>
 #include <vector>
 
@@ -10,144 +10,131 @@ namespace opentime { namespace OPENTIME_VERSION  {
     
 RationalTime RationalTime::_invalid_time {0, RationalTime::_invalid_rate};
 
-static constexpr std::array<double, 4> dropframe_timecode_rates
-{{
-    // 23.976,
-    // 23.98,
-    // 23.97,
-    // 24000.0/1001.0,
-    29.97,
-    30000.0/1001.0,
-    59.94,
-    60000.0/1001.0,
-}};
-
-// currently unused:
-/*
-static constexpr std::array<double, 10> non_dropframe_timecode_rates
-{{  1,
-    12,
-    23.976,
-    23.98,
-    24,
-    25,
-    30,
-    48,
-    50,
-    60
-}};
-*/
-
-static constexpr std::array<double, 16> valid_timecode_rates
-{{  
-    1.0,
-    12.0,
-    23.97,
-    23.976,
-    23.98,
-    24000.0/1001.0,
-    24.0,
-    25.0,
-    29.97,
-    30000.0/1001.0,
-    30.0,
-    48.0,
-    50.0,
-    59.94,
-    60000.0/1001.0,
-    60.0
-}};
-
-bool RationalTime::is_valid_timecode_rate(double fps) {
-    auto b = valid_timecode_rates.begin(),
-         e = valid_timecode_rates.end();
-    return std::find(b, e, fps) != e;
+static bool _is_digit(char c) {
+    return c >= '0' && c <= '9';
 }
 
-static bool is_dropframe_rate(double rate) {
-    auto b = dropframe_timecode_rates.begin(),
-         e = dropframe_timecode_rates.end();
-    return std::find(b, e, rate) != e;
-}
+// Reads the two character field at pos just as std::stoi(timecode.substr(pos, 2))
+// would, but without allocating or throwing.
+static bool _read_timecode_field(std::string const& timecode, size_t pos, int* value) {
+    if (pos > timecode.size()) {
+        return false;
+    }
 
-RationalTime
-RationalTime::from_timecode(std::string const& timecode, double rate, ErrorStatus* error_status) {
-    if (!RationalTime::is_valid_timecode_rate(rate)) {
-        *error_status = ErrorStatus {ErrorStatus::INVALID_TIMECODE_RATE};
-        return RationalTime::_invalid_time;
+    char const* c = timecode.data() + pos;
+    char const* end = c + std::min(timecode.size() - pos, size_t(2));
+    while (c < end && std::isspace(static_cast<unsigned char>(*c))) {
+        c++;
     }
 
-    bool rate_is_dropframe = is_dropframe_rate(rate);
+    bool negative = false;
+    if (c < end && (*c == '+' || *c == '-')) {
+        negative = (*c == '-');
+        c++;
+    }
 
-    if (timecode.find(';') != std::string::npos) {
-        if (!rate_is_dropframe) {
-            *error_status = ErrorStatus(ErrorStatus::NON_DROPFRAME_RATE,
-                                        string_printf("Timecode '%s' indicates drop frame rate due "
-                                                      "to the ';' frame divider. "
-                                                      "Passed in rate %g is of non-drop-frame-rate.",
-                                                      timecode.c_str(), rate));
-            return RationalTime::_invalid_time;
-        }
-    } else {
-        rate_is_dropframe = false;
+    if (c == end || !_is_digit(*c)) {
+        return false;
     }
 
-    std::vector<std::string> fields {"","","",""};
-    int hours, minutes, seconds, frames;
+    int v = 0;
+    while (c < end && _is_digit(*c)) {
+        v = v * 10 + (*c++ - '0');
+    }
+    *value = negative ? -v : v;
+    return true;
+}
 
-    try {
-        // split the fields
-        unsigned int last_pos = 0;
-        for (unsigned int i = 0; i < 4; i++) {
-            fields[i] = timecode.substr(last_pos, 2);
-            last_pos = last_pos+3;
-        }
+RationalTime
+RationalTime::from_timecode(std::string const& timecode, double rate, ErrorStatus* error_status) {
+    RationalTime result;
+    from_timecodes(&timecode, 1, rate, &result, error_status);
+    return result;
+}
 
-        hours   = std::stoi(fields[0]);
-        minutes = std::stoi(fields[1]);
-        seconds = std::stoi(fields[2]);
-        frames  = std::stoi(fields[3]);
-    } catch(std::exception e) {
-        *error_status = ErrorStatus(ErrorStatus::INVALID_TIMECODE_STRING,
-                                    string_printf("Input timecode '%s' is an invalid timecode",
-                                                  timecode.c_str()));
-        return RationalTime::_invalid_time;
+bool
+RationalTime::from_timecodes(std::string const* timecodes, size_t count, double rate,
+                             RationalTime* times, ErrorStatus* error_status) {
+    if (!RationalTime::is_valid_timecode_rate(rate)) {
+        *error_status = ErrorStatus {ErrorStatus::INVALID_TIMECODE_RATE};
+        std::fill(times, times + count, RationalTime::_invalid_time);
+        return false;
     }
 
+    bool rate_is_dropframe = is_dropframe_rate(rate);
     const int nominal_fps = static_cast<int>(std::ceil(rate));
 
-    if (frames >= nominal_fps) {
-        *error_status = ErrorStatus(ErrorStatus::TIMECODE_RATE_MISMATCH,
-                                    string_printf("Frame rate mismatch.  Timecode '%s' has "
-                                                  "frames beyond %d", timecode.c_str(),
-                                                  nominal_fps - 1));
-        return RationalTime::_invalid_time;
-    }
-
-    int dropframes = 0;
+    int rate_dropframes = 0;
     if (rate_is_dropframe) {
         if ((rate == 29.97) or (rate == 30000/1001.0)) {
-            dropframes = 2;
+            rate_dropframes = 2;
         }
         else if ((rate == 59.94) or (rate == 60000/1001.0)) {
-            dropframes = 4;
+            rate_dropframes = 4;
         }
     }
 
-    // to use for drop frame compensation
-    int total_minutes = hours * 60 + minutes;
-
-    // convert to frames
-    const int value = (
-        ((total_minutes * 60) + seconds) * nominal_fps 
-        + frames
-        - (
-            dropframes 
-            * (total_minutes - static_cast<int>(std::floor(total_minutes/10)))
-          )
-    );
+    bool ok = true;
+    auto fail = [&](size_t i, ErrorStatus const& status) {
+        if (ok) {
+            *error_status = status;
+            ok = false;
+        }
+        times[i] = RationalTime::_invalid_time;
+    };
+
+    for (size_t i = 0; i < count; i++) {
+        std::string const& timecode = timecodes[i];
+
+        int dropframes = 0;
+        if (timecode.find(';') != std::string::npos) {
+            if (!rate_is_dropframe) {
+                fail(i, ErrorStatus(ErrorStatus::NON_DROPFRAME_RATE,
+                                    string_printf("Timecode '%s' indicates drop frame rate due "
+                                                  "to the ';' frame divider. "
+                                                  "Passed in rate %g is of non-drop-frame-rate.",
+                                                  timecode.c_str(), rate)));
+                continue;
+            }
+            dropframes = rate_dropframes;
+        }
 
-    return RationalTime {double(value), rate};
+        int hours, minutes, seconds, frames;
+        if (!_read_timecode_field(timecode, 0, &hours) ||
+            !_read_timecode_field(timecode, 3, &minutes) ||
+            !_read_timecode_field(timecode, 6, &seconds) ||
+            !_read_timecode_field(timecode, 9, &frames)) {
+            fail(i, ErrorStatus(ErrorStatus::INVALID_TIMECODE_STRING,
+                                string_printf("Input timecode '%s' is an invalid timecode",
+                                              timecode.c_str())));
+            continue;
+        }
+
+        if (frames >= nominal_fps) {
+            fail(i, ErrorStatus(ErrorStatus::TIMECODE_RATE_MISMATCH,
+                                string_printf("Frame rate mismatch.  Timecode '%s' has "
+                                              "frames beyond %d", timecode.c_str(),
+                                              nominal_fps - 1)));
+            continue;
+        }
+
+        // to use for drop frame compensation
+        int total_minutes = hours * 60 + minutes;
+
+        // convert to frames
+        const int value = (
+            ((total_minutes * 60) + seconds) * nominal_fps
+            + frames
+            - (
+                dropframes
+                * (total_minutes - static_cast<int>(std::floor(total_minutes/10)))
+              )
+        );
+
+        times[i] = RationalTime {double(value), rate};
+    }
+
+    return ok;
 }
 
 RationalTime
@@ -191,27 +178,54 @@ RationalTime::to_timecode(
         IsDropFrameRate drop_frame,
         ErrorStatus* error_status
 ) const {
+    std::string result;
+    to_timecodes(this, 1, rate, drop_frame, &result, error_status);
+    return result;
+}
 
+static void _write_two_digits(char* p, int value) {
+    p[0] = char('0' + value / 10);
+    p[1] = char('0' + value % 10);
+}
+
+bool
+RationalTime::to_timecodes(
+        RationalTime const* times,
+        size_t count,
+        double rate,
+        IsDropFrameRate drop_frame,
+        std::string* timecodes,
+        ErrorStatus* error_status
+) {
     *error_status = ErrorStatus();
 
-    double frames_in_target_rate = this->value_rescaled_to(rate);
-    
-    if (frames_in_target_rate < 0) {
-        *error_status = ErrorStatus(ErrorStatus::NEGATIVE_VALUE);
-        return std::string();
-    }
-        
-    if (!is_valid_timecode_rate(rate)) {
-        *error_status = ErrorStatus(ErrorStatus::INVALID_TIMECODE_RATE);
-        return std::string();
-    }
+    // the rescaling is to the rate as given, whatever is made of it below
+    double const target_rate = rate;
+    ErrorStatus rate_error_status;
 
     bool rate_is_dropframe = is_dropframe_rate(rate);
-    if (drop_frame == IsDropFrameRate::ForceYes and not rate_is_dropframe) {
-        *error_status = ErrorStatus(
+    if (!is_valid_timecode_rate(rate)) {
+        rate_error_status = ErrorStatus(ErrorStatus::INVALID_TIMECODE_RATE);
+    }
+    else if (drop_frame == IsDropFrameRate::ForceYes and not rate_is_dropframe) {
+        rate_error_status = ErrorStatus(
                 ErrorStatus::INVALID_RATE_FOR_DROP_FRAME_TIMECODE
         );
-        return std::string();
+    }
+
+    // Then every time fails, and the integer math below isn't safe with the
+    // rate (it may be NaN, or too big for an int).  As for a time on its own,
+    // a negative first time is reported in preference to the rate.
+    if (rate_error_status) {
+        for (size_t i = 0; i < count; i++) {
+            timecodes[i].clear();
+        }
+        if (count == 0) {
+            return true;
+        }
+        *error_status = (times[0].value_rescaled_to(target_rate) < 0) ? ErrorStatus(ErrorStatus::NEGATIVE_VALUE)
+                                                                       : rate_error_status;
+        return false;
     }
 
     if (drop_frame != IsDropFrameRate::InferFromRate) {
@@ -253,32 +267,87 @@ RationalTime::to_timecode(
     int frames_per_minute = static_cast<int>(
             (std::round(rate) * 60) - dropframes);
 
-    // If the number of frames is more than 24 hours, roll over clock
-    double value = std::fmod(frames_in_target_rate, frames_per_24_hours);
+    int nominal_fps = static_cast<int>(std::ceil(rate));
 
-    if (rate_is_dropframe) {
-        int ten_minute_chunks = static_cast<int>(std::floor(value/frames_per_10_minutes));
-        int frames_over_ten_minutes = static_cast<int>(std::fmod(value, frames_per_10_minutes));
+    bool ok = true;
+    for (size_t i = 0; i < count; i++) {
+        double frames_in_target_rate = times[i].value_rescaled_to(target_rate);
+
+        if (frames_in_target_rate < 0) {
+            if (ok) {
+                *error_status = ErrorStatus(ErrorStatus::NEGATIVE_VALUE);
+                ok = false;
+            }
+            timecodes[i].clear();
+            continue;
+        }
 
-        if (frames_over_ten_minutes > dropframes) {
-            value += (dropframes * 9 * ten_minute_chunks) +
-                dropframes * std::floor((frames_over_ten_minutes - dropframes) / frames_per_minute);
+        // If the number of frames is more than 24 hours, roll over clock
+        double value = std::fmod(frames_in_target_rate, frames_per_24_hours);
+
+        int frames, seconds, minutes, hours;
+        if (value == std::floor(value)) {
+            // whole frames, as nearly all are, come out just the same from
+            // integer arithmetic
+            int whole_value = static_cast<int>(value);
+            if (rate_is_dropframe) {
+                int ten_minute_chunks = whole_value / frames_per_10_minutes;
+                int frames_over_ten_minutes = whole_value % frames_per_10_minutes;
+
+                whole_value += dropframes * 9 * ten_minute_chunks;
+                if (frames_over_ten_minutes > dropframes) {
+                    whole_value += dropframes * ((frames_over_ten_minutes - dropframes) / frames_per_minute);
+                }
+            }
+
+            int seconds_total = whole_value / nominal_fps;
+            frames = whole_value % nominal_fps;
+            seconds = seconds_total % 60;
+            minutes = (seconds_total / 60) % 60;
+            hours = seconds_total / 60 / 60;
         }
         else {
-            value += dropframes * 9 * ten_minute_chunks;
+            if (rate_is_dropframe) {
+                int ten_minute_chunks = static_cast<int>(std::floor(value/frames_per_10_minutes));
+                int frames_over_ten_minutes = static_cast<int>(std::fmod(value, frames_per_10_minutes));
+
+                if (frames_over_ten_minutes > dropframes) {
+                    value += (dropframes * 9 * ten_minute_chunks) +
+                        dropframes * std::floor((frames_over_ten_minutes - dropframes) / frames_per_minute);
+                }
+                else {
+                    value += dropframes * 9 * ten_minute_chunks;
+                }
+            }
+
+            // compute the fields
+            frames = static_cast<int>(std::fmod(value, nominal_fps));
+            int seconds_total = static_cast<int>(std::floor(value / nominal_fps));
+            seconds = static_cast<int>(std::fmod(seconds_total, 60));
+            minutes = static_cast<int>(std::fmod(std::floor(seconds_total / 60), 60));
+            hours = static_cast<int>(std::floor(std::floor(seconds_total / 60) / 60));
         }
-    }
 
-    int nominal_fps = static_cast<int>(std::ceil(rate));
+        // anything but two digits a field (which a time beyond all reason
+        // might come to) is left to printf
+        if (std::min({hours, minutes, seconds, frames}) < 0 ||
+            std::max({hours, minutes, seconds, frames}) > 99) {
+            timecodes[i] = string_printf("%02d:%02d:%02d%c%02d", hours, minutes, seconds, div, frames);
+            continue;
+        }
 
-    // compute the fields
-    int frames = static_cast<int>(std::fmod(value, nominal_fps));
-    int seconds_total = static_cast<int>(std::floor(value / nominal_fps));
-    int seconds = static_cast<int>(std::fmod(seconds_total, 60));
-    int minutes = static_cast<int>(std::fmod(std::floor(seconds_total / 60), 60));
-    int hours = static_cast<int>(std::floor(std::floor(seconds_total / 60) / 60));
+        char timecode[11];
+        _write_two_digits(timecode, hours);
+        timecode[2] = ':';
+        _write_two_digits(timecode + 3, minutes);
+        timecode[5] = ':';
+        _write_two_digits(timecode + 6, seconds);
+        timecode[8] = div;
+        _write_two_digits(timecode + 9, frames);
+        timecodes[i].assign(timecode, sizeof(timecode));
+    }
 
-    return string_printf("%02d:%02d:%02d%c%02d", hours, minutes, seconds, div, frames);
+    return ok;
 }
 
 std::string
@@ -16,49 +16,45 @@ enum IsDropFrameRate : int {
     
 class RationalTime {
 public:
-    explicit RationalTime(double value = 0, double rate = 1)
+    explicit constexpr RationalTime(double value = 0, double rate = 1)
     : _value {value}, _rate {rate} {}
 
     RationalTime(RationalTime const&) = default;
     RationalTime& operator= (RationalTime const&) = default;
 
-    bool is_invalid_time() const {
-        if(std::isnan(_rate) || std::isnan(_value)) {
-            return true;
-        }
-
-        return _rate <= 0;
+    constexpr bool is_invalid_time() const {
+        return _is_nan(_rate) || _is_nan(_value) || _rate <= 0;
     }
     
-    double value() const {
+    constexpr double value() const {
         return _value;
     }
 
-    double rate() const {
+    constexpr double rate() const {
         return _rate;
     }
 
-    RationalTime rescaled_to(double new_rate) const {
+    constexpr RationalTime rescaled_to(double new_rate) const {
         return RationalTime {value_rescaled_to(new_rate), new_rate};
     }
 
-    RationalTime rescaled_to(RationalTime rt) const {
+    constexpr RationalTime rescaled_to(RationalTime rt) const {
         return RationalTime {value_rescaled_to(rt._rate), rt._rate};
     }
 
-    double value_rescaled_to(double new_rate) const {
+    constexpr double value_rescaled_to(double new_rate) const {
         return new_rate == _rate ? _value : (_value * new_rate) / _rate;
     }
     
-    double value_rescaled_to(RationalTime rt) const {
+    constexpr double value_rescaled_to(RationalTime rt) const {
         return value_rescaled_to(rt._rate);
     }
 
-    bool almost_equal(RationalTime other, double delta = 0) const {
-        return fabs(value_rescaled_to(other._rate) - other._value) <= delta;
+    constexpr bool almost_equal(RationalTime other, double delta = 0) const {
+        return _fabs(value_rescaled_to(other._rate) - other._value) <= delta;
     }
 
-    static RationalTime
+    static constexpr RationalTime
     duration_from_start_end_time(RationalTime start_time, RationalTime end_time_exclusive) {
         return start_time._rate == end_time_exclusive._rate ?
             RationalTime {end_time_exclusive._value - start_time._value, start_time._rate} :
@@ -66,7 +62,7 @@ public:
                           start_time._rate};
     }
 
-    static RationalTime
+    static constexpr RationalTime
     duration_from_start_end_time_inclusive(RationalTime start_time, RationalTime end_time_inclusive) {
         return start_time._rate == end_time_inclusive._rate ?
             RationalTime {end_time_inclusive._value - start_time._value + 1, start_time._rate} :
@@ -74,28 +70,66 @@ public:
                           start_time._rate};
     }
 
-    static bool is_valid_timecode_rate(double rate);
+    static constexpr bool is_valid_timecode_rate(double rate) {
+        return _is_one_of(rate,
+                          1.0,
+                          12.0,
+                          23.97,
+                          23.976,
+                          23.98,
+                          24000.0/1001.0,
+                          24.0,
+                          25.0,
+                          29.97,
+                          30000.0/1001.0,
+                          30.0,
+                          48.0,
+                          50.0,
+                          59.94,
+                          60000.0/1001.0,
+                          60.0);
+    }
+
+    static constexpr bool is_dropframe_rate(double rate) {
+        return _is_one_of(rate,
+                          // 23.976,
+                          // 23.98,
+                          // 23.97,
+                          // 24000.0/1001.0,
+                          29.97,
+                          30000.0/1001.0,
+                          59.94,
+                          60000.0/1001.0);
+    }
     
-    static RationalTime from_frames(double frame, double rate) {
+    static constexpr RationalTime from_frames(double frame, double rate) {
         return RationalTime{double(int(frame)), rate};
     }
 
-    static RationalTime from_seconds(double seconds) {
+    static constexpr RationalTime from_seconds(double seconds) {
         return RationalTime{seconds, 1};
     }
 
     static RationalTime from_timecode(std::string const& timecode, double rate, ErrorStatus *error_status);
+
+    // Converts count timecodes at once, each just as from_timecode() would,
+    // without allocating unless there's an error to describe.  Each one that
+    // can't be converted gives an invalid time; the first such error is the one
+    // reported, and false returned.
+    static bool from_timecodes(std::string const* timecodes, size_t count, double rate,
+                               RationalTime* times, ErrorStatus *error_status);
+
     static RationalTime from_time_string(std::string const& time_string, double rate, ErrorStatus *error_status);
 
-    int to_frames() const {
+    constexpr int to_frames() const {
         return int(_value);
     }
 
-    int to_frames(double rate) const {
+    constexpr int to_frames(double rate) const {
         return int(value_rescaled_to(rate));
     }
 
-    double to_seconds() const {
+    constexpr double to_seconds() const {
         return value_rescaled_to(1);
     }
     
@@ -108,6 +142,18 @@ public:
     std::string to_timecode(ErrorStatus *error_status) const {
         return to_timecode(_rate, IsDropFrameRate::InferFromRate, error_status);
     }
+
+    // Converts count times at once, each just as to_timecode() would, into
+    // strings short enough not to need allocating.  Times that can't be
+    // converted give empty strings, as for from_timecodes().
+    static bool to_timecodes(
+            RationalTime const* times,
+            size_t count,
+            double rate,
+            IsDropFrameRate drop_frame,
+            std::string* timecodes,
+            ErrorStatus *error_status
+    );
     
     std::string to_time_string() const;
 
@@ -133,47 +179,67 @@ public:
         return *this;
     }
 
-    friend RationalTime operator+ (RationalTime lhs, RationalTime rhs) {
+    friend constexpr RationalTime operator+ (RationalTime lhs, RationalTime rhs) {
         return (lhs._rate < rhs._rate) ? RationalTime {lhs.value_rescaled_to(rhs._rate) + rhs._value, rhs._rate} :
                                          RationalTime {rhs.value_rescaled_to(lhs._rate) + lhs._value, lhs._rate};
     }
         
-    friend RationalTime operator- (RationalTime lhs, RationalTime rhs) {
+    friend constexpr RationalTime operator- (RationalTime lhs, RationalTime rhs) {
         return (lhs._rate < rhs._rate) ? RationalTime {lhs.value_rescaled_to(rhs._rate) - rhs._value, rhs._rate} :
                                          RationalTime {lhs._value - rhs.value_rescaled_to(lhs._rate), lhs._rate};
     }
 
-    friend RationalTime operator- (RationalTime lhs) {
+    friend constexpr RationalTime operator- (RationalTime lhs) {
         return RationalTime {-lhs._value, lhs._rate};
     }
 
-    friend bool operator> (RationalTime lhs, RationalTime rhs) {
+    friend constexpr bool operator> (RationalTime lhs, RationalTime rhs) {
          return (lhs._value / lhs._rate) > (rhs._value / rhs._rate);
     }
 
-    friend bool operator>= (RationalTime lhs, RationalTime rhs) {
+    friend constexpr bool operator>= (RationalTime lhs, RationalTime rhs) {
         return (lhs._value / lhs._rate) >= (rhs._value / rhs._rate);
     }
 
-    friend bool operator< (RationalTime lhs, RationalTime rhs) {
+    friend constexpr bool operator< (RationalTime lhs, RationalTime rhs) {
         return !(lhs >= rhs);
     }
 
-    friend bool operator<= (RationalTime lhs, RationalTime rhs) {
+    friend constexpr bool operator<= (RationalTime lhs, RationalTime rhs) {
         return !(lhs > rhs);
     }
 
-    friend bool operator== (RationalTime lhs, RationalTime rhs) {
+    friend constexpr bool operator== (RationalTime lhs, RationalTime rhs) {
         return lhs.value_rescaled_to(rhs._rate) == rhs._value;
     }
 
-    friend bool operator!= (RationalTime lhs, RationalTime rhs) {
+    friend constexpr bool operator!= (RationalTime lhs, RationalTime rhs) {
         return !(lhs == rhs);
     }
 
 private:
     static RationalTime _invalid_time;
     static constexpr double _invalid_rate = -1;
+
+    // std::isnan, std::find and fabs aren't constexpr until C++14 or later
+    static constexpr bool _is_nan(double x) {
+        return x != x;
+    }
+
+    static constexpr double _fabs(double x) {
+        return x < 0 ? -x : x;
+    }
+
+    // The rates are arguments rather than tables, so that there's no data
+    // for a shared library to have to export.
+    static constexpr bool _is_one_of(double) {
+        return false;
+    }
+
+    template <typename... Rates>
+    static constexpr bool _is_one_of(double rate, double first, Rates... rest) {
+        return rate == first || _is_one_of(rate, rest...);
+    }
     
     RationalTime _floor() const {
         return RationalTime {floor(_value), _rate};
@@ -27,23 +27,23 @@ constexpr double DEFAULT_EPSILON_s = 1.0 / (2 * 192000.0);
 
 class TimeRange {
 public:
-    explicit TimeRange() : _start_time{}, _duration{} {}
+    explicit constexpr TimeRange() : _start_time{}, _duration{} {}
 
-    explicit TimeRange(RationalTime start_time)
+    explicit constexpr TimeRange(RationalTime start_time)
             : _start_time{start_time}, _duration{RationalTime{0, start_time.rate()}} {}
 
-    explicit TimeRange(RationalTime start_time, RationalTime duration)
+    explicit constexpr TimeRange(RationalTime start_time, RationalTime duration)
             : _start_time{start_time}, _duration{duration} {}
 
     TimeRange(TimeRange const &) = default;
 
     TimeRange &operator=(TimeRange const &) = default;
 
-    RationalTime const &start_time() const {
+    constexpr RationalTime const &start_time() const {
         return _start_time;
     }
 
-    RationalTime const &duration() const {
+    constexpr RationalTime const &duration() const {
         return _duration;
     }
 
@@ -58,11 +58,11 @@ public:
         }
     }
 
-    RationalTime end_time_exclusive() const {
+    constexpr RationalTime end_time_exclusive() const {
         return _duration + _start_time.rescaled_to(_duration);
     }
 
-    TimeRange duration_extended_by(RationalTime other) const {
+    constexpr TimeRange duration_extended_by(RationalTime other) const {
         return TimeRange{_start_time, _duration + other};
     }
 
@@ -106,7 +106,7 @@ public:
      *              [      this      ]
      * @param other
      */
-    bool contains(RationalTime other) const {
+    constexpr bool contains(RationalTime other) const {
         return _start_time <= other && other < end_time_exclusive();
     }
 
@@ -118,12 +118,9 @@ public:
      * The converse would be <em>other.contains(this)</em>
      * @param other
      */
-    bool contains(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
-        double thisStart = _start_time.to_seconds();
-        double thisEnd = end_time_exclusive().to_seconds();
-        double otherStart = other._start_time.to_seconds();
-        double otherEnd = other.end_time_exclusive().to_seconds();
-        return greater_than(otherStart, thisStart, epsilon_s) && lesser_than(otherEnd, thisEnd, epsilon_s);
+    constexpr bool contains(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
+        return greater_than(other._start_seconds(), _start_seconds(), epsilon_s) &&
+               lesser_than(other._end_seconds(), _end_seconds(), epsilon_s);
     }
 
     /**
@@ -134,7 +131,7 @@ public:
      *              [    this    ]
      * @param other
      */
-    bool overlaps(RationalTime other) const {
+    constexpr bool overlaps(RationalTime other) const {
         return contains(other);
     }
 
@@ -147,14 +144,10 @@ public:
      * @param other
      * @param epsilon_s
      */
-    bool overlaps(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
-        double thisStart = _start_time.to_seconds();
-        double thisEnd = end_time_exclusive().to_seconds();
-        double otherStart = other._start_time.to_seconds();
-        double otherEnd = other.end_time_exclusive().to_seconds();
-        return lesser_than(thisStart, otherStart, epsilon_s) &&
-                greater_than(thisEnd, otherStart, epsilon_s) &&
-                greater_than(otherEnd, thisEnd, epsilon_s);
+    constexpr bool overlaps(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
+        return lesser_than(_start_seconds(), other._start_seconds(), epsilon_s) &&
+                greater_than(_end_seconds(), other._start_seconds(), epsilon_s) &&
+                greater_than(other._end_seconds(), _end_seconds(), epsilon_s);
     }
 
     /**
@@ -164,10 +157,8 @@ public:
      * @param other
      * @param epsilon_s
      */
-    bool before(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
-        double thisEnd = end_time_exclusive().to_seconds();
-        double otherStart = other._start_time.to_seconds();
-        return greater_than(otherStart, thisEnd, epsilon_s);
+    constexpr bool before(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
+        return greater_than(other._start_seconds(), _end_seconds(), epsilon_s);
     }
 
     /**
@@ -178,10 +169,8 @@ public:
      * @param other
      * @param epsilon_s
      */
-    bool before(RationalTime other, double epsilon_s = DEFAULT_EPSILON_s) const {
-        double thisEnd = end_time_exclusive().to_seconds();
-        double otherTime = other.to_seconds();
-        return lesser_than(thisEnd, otherTime, epsilon_s);
+    constexpr bool before(RationalTime other, double epsilon_s = DEFAULT_EPSILON_s) const {
+        return lesser_than(_end_seconds(), other.to_seconds(), epsilon_s);
     }
 
     /**
@@ -192,10 +181,9 @@ public:
      * @param other
      * @param epsilon_s
      */
-    bool meets(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
-        double thisEnd = end_time_exclusive().to_seconds();
-        double otherStart = other._start_time.to_seconds();
-        return otherStart - thisEnd <= epsilon_s && otherStart - thisEnd >= 0;
+    constexpr bool meets(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
+        return other._start_seconds() - _end_seconds() <= epsilon_s &&
+               other._start_seconds() - _end_seconds() >= 0;
     }
 
     /**
@@ -207,12 +195,9 @@ public:
      * @param other
      * @param epsilon_s
      */
-    bool begins(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
-        double thisStart = _start_time.to_seconds();
-        double thisEnd = end_time_exclusive().to_seconds();
-        double otherStart = other._start_time.to_seconds();
-        double otherEnd = other.end_time_exclusive().to_seconds();
-        return fabs(otherStart - thisStart) <= epsilon_s && lesser_than(thisEnd, otherEnd, epsilon_s);
+    constexpr bool begins(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
+        return _fabs(other._start_seconds() - _start_seconds()) <= epsilon_s &&
+               lesser_than(_end_seconds(), other._end_seconds(), epsilon_s);
     }
 
     /**
@@ -223,10 +208,8 @@ public:
      *              [ this ]
      * @param other
      */
-    bool begins(RationalTime other, double epsilon_s = DEFAULT_EPSILON_s) const {
-        double thisStart = _start_time.to_seconds();
-        double otherStart = other.to_seconds();
-        return fabs(otherStart - thisStart) <= epsilon_s;
+    constexpr bool begins(RationalTime other, double epsilon_s = DEFAULT_EPSILON_s) const {
+        return _fabs(other.to_seconds() - _start_seconds()) <= epsilon_s;
     }
 
     /**
@@ -238,12 +221,9 @@ public:
      * @param other
      * @param epsilon_s
      */
-    bool finishes(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
-        double thisStart = _start_time.to_seconds();
-        double thisEnd = end_time_exclusive().to_seconds();
-        double otherStart = other._start_time.to_seconds();
-        double otherEnd = other.end_time_exclusive().to_seconds();
-        return fabs(thisEnd - otherEnd) <= epsilon_s && greater_than(thisStart, otherStart, epsilon_s);
+    constexpr bool finishes(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
+        return _fabs(_end_seconds() - other._end_seconds()) <= epsilon_s &&
+               greater_than(_start_seconds(), other._start_seconds(), epsilon_s);
     }
 
     /**
@@ -255,10 +235,8 @@ public:
      * @param other
      * @param epsilon_s
      */
-    bool finishes(RationalTime other, double epsilon_s = DEFAULT_EPSILON_s) const {
-        double thisEnd = end_time_exclusive().to_seconds();
-        double otherEnd = other.to_seconds();
-        return fabs(thisEnd - otherEnd) <= epsilon_s;
+    constexpr bool finishes(RationalTime other, double epsilon_s = DEFAULT_EPSILON_s) const {
+        return _fabs(_end_seconds() - other.to_seconds()) <= epsilon_s;
     }
 
     /**
@@ -270,12 +248,9 @@ public:
      * @param other
      * @param epsilon_s
      */
-    bool intersects(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
-        double thisStart = _start_time.to_seconds();
-        double thisEnd = end_time_exclusive().to_seconds();
-        double otherStart = other._start_time.to_seconds();
-        double otherEnd = other.end_time_exclusive().to_seconds();
-        return lesser_than(thisStart, otherEnd, epsilon_s) && greater_than(thisEnd, otherStart, epsilon_s);
+    constexpr bool intersects(TimeRange other, double epsilon_s = DEFAULT_EPSILON_s) const {
+        return lesser_than(_start_seconds(), other._end_seconds(), epsilon_s) &&
+               greater_than(_end_seconds(), other._start_seconds(), epsilon_s);
     }
 
 
@@ -287,11 +262,9 @@ public:
      * @param lhs
      * @param rhs
      */
-    friend bool operator==(TimeRange lhs, TimeRange rhs) {
-        RationalTime start = lhs._start_time - rhs._start_time;
-        RationalTime duration = lhs._duration - rhs._duration;
-        return fabs(start.to_seconds()) < DEFAULT_EPSILON_s &&
-               fabs(duration.to_seconds()) < DEFAULT_EPSILON_s;
+    friend constexpr bool operator==(TimeRange lhs, TimeRange rhs) {
+        return _fabs((lhs._start_time - rhs._start_time).to_seconds()) < DEFAULT_EPSILON_s &&
+               _fabs((lhs._duration - rhs._duration).to_seconds()) < DEFAULT_EPSILON_s;
     }
 
     /**
@@ -299,16 +272,16 @@ public:
      * @param lhs
      * @param rhs
      */
-    friend bool operator!=(TimeRange lhs, TimeRange rhs) {
+    friend constexpr bool operator!=(TimeRange lhs, TimeRange rhs) {
         return !(lhs == rhs);
     }
 
-    static TimeRange range_from_start_end_time(RationalTime start_time, RationalTime end_time_exclusive) {
+    static constexpr TimeRange range_from_start_end_time(RationalTime start_time, RationalTime end_time_exclusive) {
         return TimeRange{start_time,
                          RationalTime::duration_from_start_end_time(start_time, end_time_exclusive)};
     }
 
-    static TimeRange range_from_start_end_time_inclusive(RationalTime start_time, RationalTime end_time_inclusive) {
+    static constexpr TimeRange range_from_start_end_time_inclusive(RationalTime start_time, RationalTime end_time_inclusive) {
         return TimeRange{start_time,
                          RationalTime::duration_from_start_end_time_inclusive(start_time, end_time_inclusive)};
     }
@@ -317,13 +290,25 @@ private:
     RationalTime _start_time, _duration;
     friend class TimeTransform;
 
-    inline bool greater_than(double lhs, double rhs, double epsilon) const{
+    static constexpr bool greater_than(double lhs, double rhs, double epsilon) {
         return lhs - rhs >= epsilon;
     }
 
-    inline bool lesser_than(double lhs, double rhs, double epsilon) const{
+    static constexpr bool lesser_than(double lhs, double rhs, double epsilon) {
         return rhs - lhs >= epsilon;
     }
+
+    static constexpr double _fabs(double x) {
+        return RationalTime::_fabs(x);
+    }
+
+    constexpr double _start_seconds() const {
+        return _start_time.to_seconds();
+    }
+
+    constexpr double _end_seconds() const {
+        return end_time_exclusive().to_seconds();
+    }
 };
 
 } }
@@ -0,0 +1,140 @@
+#include "opentime/timeRangeArray.h"
+#include <algorithm>
+
+namespace opentime { namespace OPENTIME_VERSION  {
+
+/*
+ * The tests below work out each range's start and end in seconds with the
+ * same operations, in the same order, as RationalTime::to_seconds() and
+ * TimeRange::end_time_exclusive() would for it, so that their results match
+ * the scalar predicates bit for bit.
+ *
+ * The comparisons are combined with & rather than && so that there are no
+ * branches.  Compilers won't vectorize a loop that compares doubles and
+ * stores bools unless they can target AVX or SSE4, so each test gives 1.0 or
+ * 0.0 instead, and _test_each() narrows those to bools a block at a time.
+ * Both of its loops vectorize with plain SSE2 or NEON.
+ */
+
+static double _one_if(bool condition) {
+    return condition ? 1.0 : 0.0;
+}
+
+template <typename Test>
+static void _test_each(size_t count, bool* results, Test test) {
+    static constexpr size_t block_size = 256;
+    double passed[block_size];
+
+    for (size_t first = 0; first < count; first += block_size) {
+        size_t n = std::min(count - first, block_size);
+        for (size_t i = 0; i < n; i++) {
+            passed[i] = test(first + i);
+        }
+        for (size_t i = 0; i < n; i++) {
+            results[first + i] = int(passed[i]) != 0;
+        }
+    }
+}
+
+TimeRangeArray::TimeRangeArray(std::vector<TimeRange> const& ranges, double rate)
+    : _rate{rate} {
+    reserve(ranges.size());
+    for (auto range: ranges) {
+        push_back(range);
+    }
+}
+
+void TimeRangeArray::contains(RationalTime other, bool* results) const {
+    double const* starts = _start_values.data();
+    double const* durations = _duration_values.data();
+    double const rate = _rate;
+    double const other_seconds = other.value() / other.rate();
+
+    _test_each(size(), results, [=](size_t i) {
+        return _one_if(!(starts[i] / rate > other_seconds) &
+                       !(other_seconds >= (starts[i] + durations[i]) / rate));
+    });
+}
+
+void TimeRangeArray::contains(TimeRange other, bool* results, double epsilon_s) const {
+    double const* starts = _start_values.data();
+    double const* durations = _duration_values.data();
+    double const rate = _rate;
+    double const other_start = other.start_time().to_seconds();
+    double const other_end = other.end_time_exclusive().to_seconds();
+
+    _test_each(size(), results, [=](size_t i) {
+        return _one_if((other_start - starts[i] / rate >= epsilon_s) &
+                       ((starts[i] + durations[i]) / rate - other_end >= epsilon_s));
+    });
+}
+
+void TimeRangeArray::overlaps(TimeRange other, bool* results, double epsilon_s) const {
+    double const* starts = _start_values.data();
+    double const* durations = _duration_values.data();
+    double const rate = _rate;
+    double const other_start = other.start_time().to_seconds();
+    double const other_end = other.end_time_exclusive().to_seconds();
+
+    _test_each(size(), results, [=](size_t i) {
+        double end = (starts[i] + durations[i]) / rate;
+        return _one_if((other_start - starts[i] / rate >= epsilon_s) &
+                       (end - other_start >= epsilon_s) &
+                       (other_end - end >= epsilon_s));
+    });
+}
+
+void TimeRangeArray::intersects(TimeRange other, bool* results, double epsilon_s) const {
+    double const* starts = _start_values.data();
+    double const* durations = _duration_values.data();
+    double const rate = _rate;
+    double const other_start = other.start_time().to_seconds();
+    double const other_end = other.end_time_exclusive().to_seconds();
+
+    _test_each(size(), results, [=](size_t i) {
+        return _one_if((other_end - starts[i] / rate >= epsilon_s) &
+                       ((starts[i] + durations[i]) / rate - other_start >= epsilon_s));
+    });
+}
+
+TimeRangeArray TimeRangeArray::clamped_by(TimeRange window) const {
+    TimeRangeArray result(_rate);
+    result._start_values.resize(size());
+    result._duration_values.resize(size());
+
+    double const* starts = _start_values.data();
+    double const* durations = _duration_values.data();
+    double* clamped_starts = result._start_values.data();
+    double* clamped_durations = result._duration_values.data();
+    double const rate = _rate;
+    double const window_start = window.start_time().value_rescaled_to(rate);
+    double const window_end = window_start + window.duration().value_rescaled_to(rate);
+
+    for (size_t i = 0, n = size(); i < n; i++) {
+        double start = !(starts[i] / rate >= window_start / rate) ? window_start : starts[i];
+        double end = start + durations[i];
+        end = !(window_end / rate >= end / rate) ? window_end : end;
+        clamped_starts[i] = start;
+        clamped_durations[i] = end - start;
+    }
+    return result;
+}
+
+TimeRange TimeRangeArray::extent() const {
+    if (empty()) {
+        return TimeRange{RationalTime{0, _rate}};
+    }
+
+    double const rate = _rate;
+    double start = _start_values[0], duration = _duration_values[0];
+    for (size_t i = 1, n = size(); i < n; i++) {
+        double end = start + duration;
+        double other_end = _start_values[i] + _duration_values[i];
+        start = !(_start_values[i] / rate >= start / rate) ? _start_values[i] : start;
+        end = !(end / rate >= other_end / rate) ? other_end : end;
+        duration = end - start;
+    }
+    return TimeRange{RationalTime{start, rate}, RationalTime{duration, rate}};
+}
+
+} }
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "opentime/version.h"
+#include "opentime/timeRange.h"
+#include <vector>
+
+namespace opentime { namespace OPENTIME_VERSION  {
+
+/**
+ * Many TimeRanges at one rate, kept as an array of start values and an array
+ * of duration values, so that a relation can be tested against all of them
+ * in one pass that the compiler can vectorize.
+ *
+ * Each relation writes one result per range to results, which must have
+ * room for size() of them.  Result i is exactly what the TimeRange method of
+ * the same name gives for range(i).
+ */
+class TimeRangeArray {
+public:
+    explicit TimeRangeArray(double rate = 1) : _rate{rate} {}
+
+    // The ranges given, each rescaled to rate.
+    explicit TimeRangeArray(std::vector<TimeRange> const& ranges, double rate);
+
+    double rate() const {
+        return _rate;
+    }
+
+    size_t size() const {
+        return _start_values.size();
+    }
+
+    bool empty() const {
+        return _start_values.empty();
+    }
+
+    std::vector<double> const& start_values() const {
+        return _start_values;
+    }
+
+    std::vector<double> const& duration_values() const {
+        return _duration_values;
+    }
+
+    TimeRange range(size_t index) const {
+        return TimeRange{RationalTime{_start_values[index], _rate}, RationalTime{_duration_values[index], _rate}};
+    }
+
+    void reserve(size_t count) {
+        _start_values.reserve(count);
+        _duration_values.reserve(count);
+    }
+
+    void clear() {
+        _start_values.clear();
+        _duration_values.clear();
+    }
+
+    // Adds range, rescaled to rate().
+    void push_back(TimeRange range) {
+        _start_values.push_back(range.start_time().value_rescaled_to(_rate));
+        _duration_values.push_back(range.duration().value_rescaled_to(_rate));
+    }
+
+    void contains(RationalTime other, bool* results) const;
+    void contains(TimeRange other, bool* results, double epsilon_s = DEFAULT_EPSILON_s) const;
+
+    void overlaps(RationalTime other, bool* results) const {
+        contains(other, results);
+    }
+
+    void overlaps(TimeRange other, bool* results, double epsilon_s = DEFAULT_EPSILON_s) const;
+    void intersects(TimeRange other, bool* results, double epsilon_s = DEFAULT_EPSILON_s) const;
+
+    // Each range as window.clamped() gives it, once window is rescaled to rate().
+    TimeRangeArray clamped_by(TimeRange window) const;
+
+    // All the ranges joined up just as folding them with extended_by() from
+    // the first would, or an empty range at rate() if there are none.
+    TimeRange extent() const;
+
+private:
+    double _rate;
+    std::vector<double> _start_values, _duration_values;
+};
+
+} }
@@ -0,0 +1,107 @@
+#include "opentimelineio/anyDictionary.h"
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
+
+static size_t _hash(std::string const& key) {
+    return std::hash<std::string>()(key);
+}
+
+void AnyDictionary::_sort_entries() {
+    std::stable_sort(_entries.begin(), _entries.end(),
+                     [](value_type const& lhs, value_type const& rhs) { return lhs.first < rhs.first; });
+    _entries.erase(std::unique(_entries.begin(), _entries.end(),
+                               [](value_type const& lhs, value_type const& rhs) { return lhs.first == rhs.first; }),
+                   _entries.end());
+    _rebuild_index();
+}
+
+void AnyDictionary::_rebuild_index() {
+    if (_entries.size() <= _hash_threshold) {
+        delete _index;
+        _index = nullptr;
+        return;
+    }
+
+    // keep at least half the slots empty
+    size_t slot_count = 4 * _hash_threshold;
+    while (slot_count < 2 * _entries.size()) {
+        slot_count *= 2;
+    }
+
+    if (!_index) {
+        _index = new _HashIndex;
+    }
+    _index->slots.assign(slot_count, _empty_slot);
+    _index->used = _entries.size();
+
+    size_t mask = slot_count - 1;
+    for (size_t i = 0; i < _entries.size(); i++) {
+        size_t slot = _hash(_entries[i].first) & mask;
+        while (_index->slots[slot] != _empty_slot) {
+            slot = (slot + 1) & mask;
+        }
+        _index->slots[slot] = uint32_t(i + 1);
+    }
+}
+
+AnyDictionary::size_type AnyDictionary::_index_find(key_type const& key) const {
+    std::vector<uint32_t> const& slots = _index->slots;
+    size_t mask = slots.size() - 1;
+    for (size_t slot = _hash(key) & mask; slots[slot] != _empty_slot; slot = (slot + 1) & mask) {
+        uint32_t entry = slots[slot];
+        if (entry != _erased_slot && _entries[entry - 1].first == key) {
+            return entry - 1;
+        }
+    }
+    return _entries.size();
+}
+
+// Called once the entry at position has been inserted.
+void AnyDictionary::_index_insert(size_type position) {
+    if (!_index || 2 * (_index->used + 1) > _index->slots.size()) {
+        _rebuild_index();
+        return;
+    }
+
+    std::vector<uint32_t>& slots = _index->slots;
+    if (position + 1 != _entries.size()) {
+        // the entries after the new one all moved up by one
+        for (uint32_t& entry: slots) {
+            if (entry != _erased_slot && entry > position) {
+                entry++;
+            }
+        }
+    }
+
+    size_t mask = slots.size() - 1;
+    size_t slot = _hash(_entries[position].first) & mask;
+    while (slots[slot] != _empty_slot) {
+        slot = (slot + 1) & mask;
+    }
+    slots[slot] = uint32_t(position + 1);
+    _index->used++;
+}
+
+// Called before the entry at position is erased.
+void AnyDictionary::_index_erase(size_type position) {
+    if (!_index) {
+        return;
+    }
+
+    std::vector<uint32_t>& slots = _index->slots;
+    size_t mask = slots.size() - 1;
+    size_t slot = _hash(_entries[position].first) & mask;
+    while (slots[slot] != position + 1) {
+        slot = (slot + 1) & mask;
+    }
+    slots[slot] = _erased_slot;
+
+    // the entries after the erased one all move down by one
+    for (uint32_t& entry: slots) {
+        if (entry != _erased_slot && entry > position + 1) {
+            entry--;
+        }
+    }
+}
+
+} }
@@ -3,134 +3,286 @@
 #include "opentimelineio/version.h"
 #include "opentimelineio/any.h"
 
+#include <algorithm>
 #include <assert.h>
-#include <map>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <stdint.h>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
 /*
- * An AnyDictionary has exactly the same API as
+ * An AnyDictionary has much the same API as
  *    std::map<std::string, any>
  *
- * except that it records a "time-stamp" that bumps monotonically every time an
+ * and, like it, iterates over its entries in order of their keys.  Metadata
+ * dictionaries are mostly small though, so rather than a tree of nodes, the
+ * entries are kept sorted in a single vector, which is searched by bisection;
+ * once a dictionary grows past _hash_threshold entries, a hash index over the
+ * vector takes over finding keys.  As with a vector, and unlike a map,
+ * inserting or erasing an entry invalidates iterators and references to the
+ * others.  (value_type is a pair of non-const key and value, but changing a
+ * key in place is not allowed.)
+ *
+ * It also records a "time-stamp" that bumps monotonically every time an
  * operation that would invalidate iterators is performed.
- * (This happens for operator=, clear, erase, insert, swap).  The stamp also
- * lets external observers know when the map has been destroyed (which includes
- * the case of the map being relocated in memory).
+ * (This happens for operator=, clear, erase, swap, and anything that inserts
+ * an entry.)  The stamp also lets external observers know when the map has
+ * been destroyed (which includes the case of the map being relocated in
+ * memory).
  *
  * This allows us to hand out iterators that can be aware of mutation and moves
  * and take steps to safe-guard themselves from causing a crash.  (Yes,
  * I'm talking to you, Python...)
  */
-class AnyDictionary : private std::map<std::string, any> {
+class AnyDictionary {
 public:
-    using map::map;
+    using key_type = std::string;
+    using mapped_type = any;
+    using value_type = std::pair<std::string, any>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using key_compare = std::less<std::string>;
+    using reference = value_type&;
+    using const_reference = value_type const&;
+    using pointer = value_type*;
+    using const_pointer = value_type const*;
+    using iterator = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+    using reverse_iterator = std::vector<value_type>::reverse_iterator;
+    using const_reverse_iterator = std::vector<value_type>::const_reverse_iterator;
+
+    AnyDictionary() : _mutation_stamp {} {}
+
+    // as with std::map, the first of any entries with the same key wins
+    AnyDictionary(std::initializer_list<value_type> ilist) : _entries (ilist), _mutation_stamp {} {
+        _sort_entries();
+    }
+
+    template <typename InputIt>
+    AnyDictionary(InputIt first, InputIt last) : _entries (first, last), _mutation_stamp {} {
+        _sort_entries();
+    }
 
-    AnyDictionary() : map {}, _mutation_stamp {} {}
-    
     // to be safe, avoid brace-initialization so as to not trigger
     // list initialization behavior in older compilers:
-    AnyDictionary(const AnyDictionary& other) : map (other), _mutation_stamp {} {}
+    AnyDictionary(const AnyDictionary& other) : _entries (other._entries), _mutation_stamp {} {
+        _rebuild_index();
+    }
+
+    // moving leaves other empty, which counts as a mutation of it
+    AnyDictionary(AnyDictionary&& other) noexcept : _entries (std::move(other._entries)), _mutation_stamp {} {
+        other.mutate();
+        other._entries.clear();
+        std::swap(_index, other._index);
+    }
     
     ~AnyDictionary() {
         if (_mutation_stamp) {
             _mutation_stamp->stamp = -1;
             _mutation_stamp->any_dictionary = nullptr;
+            _mutation_stamp->shared = nullptr;
         }
+        delete _index;
     }
     
     AnyDictionary& operator=(const AnyDictionary& other) {
-        mutate();
-        map::operator= (other);
+        if (this != &other) {
+            mutate();
+            _entries = other._entries;
+            _rebuild_index();
+        }
         return *this;
     }
 
-    AnyDictionary& operator=(AnyDictionary&& other) {
-        mutate();
-        other.mutate();
-        map::operator= (other);
+    AnyDictionary& operator=(AnyDictionary&& other) noexcept {
+        if (this != &other) {
+            mutate();
+            other.mutate();
+            _entries.swap(other._entries);
+            std::swap(_index, other._index);
+            other.clear();
+        }
         return *this;
     }
 
     AnyDictionary& operator=(std::initializer_list<value_type> ilist) {
         mutate();
-        map::operator= (ilist);
+        _entries = ilist;
+        _sort_entries();
         return *this;
     }
 
-    using map::get_allocator;
+    any& at(key_type const& key) {
+        iterator it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("AnyDictionary::at: no such key");
+        }
+        return it->second;
+    }
+
+    any const& at(key_type const& key) const {
+        const_iterator it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("AnyDictionary::at: no such key");
+        }
+        return it->second;
+    }
+
+    any& operator[](key_type const& key) {
+        return _find_or_insert(key)->second;
+    }
 
-    using map::at;
-    using map::operator[];
+    any& operator[](key_type&& key) {
+        return _find_or_insert(std::move(key))->second;
+    }
 
-    using map::begin;
-    using map::cbegin;
-    using map::end;
-    using map::cend;
-    using map::rbegin;
-    using map::crbegin;
-    using map::rend;
-    using map::crend;
+    iterator begin() noexcept { return _entries.begin(); }
+    const_iterator begin() const noexcept { return _entries.begin(); }
+    const_iterator cbegin() const noexcept { return _entries.cbegin(); }
+    iterator end() noexcept { return _entries.end(); }
+    const_iterator end() const noexcept { return _entries.end(); }
+    const_iterator cend() const noexcept { return _entries.cend(); }
+    reverse_iterator rbegin() noexcept { return _entries.rbegin(); }
+    const_reverse_iterator rbegin() const noexcept { return _entries.rbegin(); }
+    const_reverse_iterator crbegin() const noexcept { return _entries.crbegin(); }
+    reverse_iterator rend() noexcept { return _entries.rend(); }
+    const_reverse_iterator rend() const noexcept { return _entries.rend(); }
+    const_reverse_iterator crend() const noexcept { return _entries.crend(); }
 
     void clear() noexcept {
         mutate();
-        map::clear();
+        _entries.clear();
+        delete _index;
+        _index = nullptr;
+    }
+
+    std::pair<iterator, bool> insert(value_type const& value) {
+        return _insert(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return _insert(std::move(value));
+    }
+
+    iterator insert(const_iterator /* hint */, value_type const& value) {
+        return _insert(value).first;
+    }
+
+    iterator insert(const_iterator /* hint */, value_type&& value) {
+        return _insert(std::move(value)).first;
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            _insert(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        return _insert(value_type(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator /* hint */, Args&&... args) {
+        return _insert(value_type(std::forward<Args>(args)...)).first;
     }
-    using map::insert;
-    using map::emplace;
-    using map::emplace_hint;
 
     iterator erase(const_iterator pos) {
         mutate();
-        return map::erase(pos);
+        size_type position = size_type(pos - _entries.cbegin());
+        _index_erase(position);
+        return _entries.erase(_entries.begin() + position);
     }
         
     iterator erase(const_iterator first, const_iterator last) {
         mutate();
-        return map::erase(first, last);
+        iterator result = _entries.erase(first, last);
+        size_type position = size_type(result - _entries.begin());
+        _rebuild_index();
+        return _entries.begin() + position;
     }
     
     size_type erase(const key_type& key) {
-        mutate();
-        return map::erase(key);
+        iterator it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        erase(it);
+        return 1;
     }
 
     void swap(AnyDictionary& other) {
         mutate();
         other.mutate();
-        map::swap(other);
+        _entries.swap(other._entries);
+        std::swap(_index, other._index);
     }
     
-    using map::empty;
-    using map::size;
-    using map::max_size;
-
-    using map::count;
-    using map::find;
-    using map::equal_range;
-    using map::lower_bound;
-    using map::upper_bound;
-
-    using map::key_comp;
-    using map::value_comp;
-
-    using map::key_type;
-    using map::mapped_type;
-    using map::value_type;
-    using map::size_type;
-    using map::difference_type;
-    using map::key_compare;
-    using map::allocator_type;
-    using map::reference;
-    using map::const_reference;
-    using map::pointer;
-    using map::const_pointer;
-    using map::iterator;
-    using map::const_iterator;
-    using map::reverse_iterator;
-    using map::const_reverse_iterator;
-    
+    bool empty() const noexcept { return _entries.empty(); }
+    size_type size() const noexcept { return _entries.size(); }
+    size_type max_size() const noexcept { return _entries.max_size(); }
+
+    // not part of std::map: makes room for count entries, without
+    // invalidating iterators if there already is room
+    void reserve(size_type count) {
+        if (count > _entries.capacity()) {
+            mutate();
+            _entries.reserve(count);
+        }
+    }
+
+    size_type count(key_type const& key) const {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    iterator find(key_type const& key) {
+        return _entries.begin() + _find_position(key);
+    }
+
+    const_iterator find(key_type const& key) const {
+        return _entries.begin() + _find_position(key);
+    }
+
+    iterator lower_bound(key_type const& key) {
+        return std::lower_bound(_entries.begin(), _entries.end(), key, _KeyLess());
+    }
+
+    const_iterator lower_bound(key_type const& key) const {
+        return std::lower_bound(_entries.begin(), _entries.end(), key, _KeyLess());
+    }
+
+    iterator upper_bound(key_type const& key) {
+        return std::upper_bound(_entries.begin(), _entries.end(), key, _KeyLess());
+    }
+
+    const_iterator upper_bound(key_type const& key) const {
+        return std::upper_bound(_entries.begin(), _entries.end(), key, _KeyLess());
+    }
+
+    std::pair<iterator, iterator> equal_range(key_type const& key) {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(key_type const& key) const {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    key_compare key_comp() const {
+        return key_compare();
+    }
+
     struct MutationStamp {
         MutationStamp(AnyDictionary* d)
         : stamp {1}, any_dictionary {d}, owning {false} {
@@ -153,6 +305,13 @@ public:
         AnyDictionary* any_dictionary;
         bool owning;
 
+        // Set while the owner of any_dictionary keeps its entries in a copy
+        // shared with others (as SerializableObjectWithMetadata does after
+        // clone()).  shared is then to be read in place of any_dictionary,
+        // and unshare() called to put the entries back before writing.
+        AnyDictionary const* shared = nullptr;
+        std::function<void ()> unshare;
+
     protected:
         MutationStamp() : stamp {1}, any_dictionary {new AnyDictionary}, owning {true} {
             any_dictionary->_mutation_stamp = this;
@@ -165,18 +324,116 @@ public:
         }
         return _mutation_stamp;
     }
+
+    // The stamp get_or_create_mutation_stamp() handed out, if any is still
+    // held.
+    MutationStamp* mutation_stamp() const {
+        return _mutation_stamp;
+    }
     
     friend struct MutationStamp;
     
 private:
+    // Dictionaries with more entries than this look keys up through _index.
+    enum { _hash_threshold = 16 };
+
+    struct _KeyLess {
+        bool operator()(value_type const& entry, key_type const& key) const {
+            return entry.first < key;
+        }
+
+        bool operator()(key_type const& key, value_type const& entry) const {
+            return key < entry.first;
+        }
+    };
+
+    /*
+     * Open addressing over the positions of the entries: each slot holds an
+     * entry's position plus one, or _empty_slot, or _erased_slot where an
+     * entry was removed.  Only non-const members ever change it, so const
+     * lookups stay safe from several threads at once.
+     */
+    struct _HashIndex {
+        std::vector<uint32_t> slots;
+        size_t used;    // slots that are not _empty_slot
+    };
+
+    enum : uint32_t { _empty_slot = 0, _erased_slot = 0xffffffff };
+
+    std::vector<value_type> _entries;
     MutationStamp* _mutation_stamp = nullptr;
+    _HashIndex* _index = nullptr;
     
-    void mutate() {
+    void mutate() noexcept {
         if (_mutation_stamp) {
             _mutation_stamp->stamp++;
         }
     }
+
+    // Where key is, or size() if it isn't.
+    size_type _find_position(key_type const& key) const {
+        if (_index) {
+            return _index_find(key);
+        }
+
+        auto it = lower_bound(key);
+        return (it != _entries.end() && it->first == key) ? size_type(it - _entries.begin()) : _entries.size();
+    }
+
+    // Where an entry for key goes, or is already (as told by *found).
+    iterator _insertion_point(key_type const& key, bool* found) {
+        // keys often arrive in order, as they do when reading a file
+        if (_entries.empty() || _entries.back().first < key) {
+            *found = false;
+            return _entries.end();
+        }
+
+        iterator it = lower_bound(key);
+        *found = (it->first == key);
+        return it;
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> _insert(V&& value) {
+        bool found;
+        iterator it = _insertion_point(value.first, &found);
+        if (found) {
+            return std::make_pair(it, false);
+        }
+        return std::make_pair(_insert_at(it, std::forward<V>(value)), true);
+    }
+
+    template <typename K>
+    iterator _find_or_insert(K&& key) {
+        bool found;
+        iterator it = _insertion_point(key, &found);
+        if (found) {
+            return it;
+        }
+        return _insert_at(it, value_type(std::forward<K>(key), any()));
+    }
+
+    template <typename V>
+    iterator _insert_at(iterator it, V&& value) {
+        mutate();
+        size_type position = size_type(it - _entries.begin());
+        _entries.insert(it, std::forward<V>(value));
+        _index_insert(position);
+        return _entries.begin() + position;
+    }
+
+    void _sort_entries();
+    void _rebuild_index();
+    size_type _index_find(key_type const& key) const;
+    void _index_insert(size_type position);
+    void _index_erase(size_type position);
 };
 
+// so that containers of them (like the JSON decoder's stack) move them when
+// they grow, rather than copying
+static_assert(std::is_nothrow_move_constructible<AnyDictionary>::value &&
+              std::is_nothrow_move_assignable<AnyDictionary>::value,
+              "AnyDictionary must move without throwing");
+
 } }
 
@@ -2,6 +2,8 @@
 
 #include "opentimelineio/version.h"
 #include "opentimelineio/any.h"
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <assert.h>
 
@@ -29,6 +31,8 @@ public:
     // list initialization behavior in older compilers:
     AnyVector(const AnyVector& other) : vector (other), _mutation_stamp {nullptr} {}
 
+    AnyVector(AnyVector&& other) noexcept : vector (std::move(other)), _mutation_stamp {nullptr} {}
+
     ~AnyVector() {
         if (_mutation_stamp) {
             _mutation_stamp->any_vector = nullptr;
@@ -40,8 +44,8 @@ public:
         return *this;
     }
 
-    AnyVector& operator=(AnyVector&& other) {
-        vector::operator= (other);
+    AnyVector& operator=(AnyVector&& other) noexcept {
+        vector::operator= (std::move(other));
         return *this;
     }
 
@@ -134,6 +138,12 @@ public:
         }
         return _mutation_stamp;
     }
+
+    // The stamp get_or_create_mutation_stamp() handed out, if any is still
+    // held.
+    MutationStamp* mutation_stamp() const {
+        return _mutation_stamp;
+    }
     
     friend struct MutationStamp;
     
@@ -141,5 +151,10 @@ private:
     MutationStamp* _mutation_stamp = nullptr;
 };
 
+// see the same for AnyDictionary
+static_assert(std::is_nothrow_move_constructible<AnyVector>::value &&
+              std::is_nothrow_move_assignable<AnyVector>::value,
+              "AnyVector must move without throwing");
+
 } }
 
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "opentimelineio/version.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
+
+/*
+ * The layout shared by the binary encoder and decoder.  It holds the same
+ * values as the JSON form, so either can be converted to the other without
+ * loss.  Laid out in order, the input holds:
+ *
+ *   - the magic bytes "OTIOB", a version byte and a flags byte;
+ *   - the root value;
+ *   - the string table: a count, then the length and bytes of each string;
+ *   - if the has_object_offsets flag is set, a count followed by the offset
+ *     of each object (with a schema) from the start of the input, each as
+ *     the difference from the one before, in the order the objects start;
+ *   - the offset of the string table, as eight little-endian bytes.
+ *
+ * Each value is a tag byte followed by:
+ *
+ *   null, false, true        nothing
+ *   integer                  a varint of the value, zig-zag encoded
+ *   unsigned_integer         a varint
+ *   number                   a little-endian double
+ *   string                   a varint length, then the bytes
+ *   table_string             a varint index into the string table
+ *   rational_time            value and rate, as doubles
+ *   time_range               start time value and rate, duration value
+ *                            and rate, as doubles
+ *   time_transform           offset value and rate, scale and rate, as
+ *                            doubles
+ *   array                    a varint count, then that many values
+ *   object                   for each member, a varint of one more than the
+ *                            index of its key in the string table followed
+ *                            by its value; then a zero
+ *
+ * Keys, and the schema names under OTIO_SCHEMA, all go in the string table.
+ * Counts and lengths are varints: seven bits to a byte, low bits first, the
+ * top bit set on all but the last byte.
+ */
+namespace binary_format {
+
+static char const magic[] = "OTIOB";
+static size_t const magic_size = 5;
+static uint8_t const version = 1;
+static size_t const header_size = magic_size + 2;
+static size_t const trailer_size = 8;
+
+enum Flags : uint8_t {
+    has_object_offsets = 1,
+};
+
+enum Tag : uint8_t {
+    null = 0,
+    false_value,
+    true_value,
+    integer,
+    unsigned_integer,
+    number,
+    string,
+    table_string,
+    rational_time,
+    time_range,
+    time_transform,
+    array,
+    object,
+};
+
+inline void append_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += char((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += char(value);
+}
+
+inline void append_fixed64(std::string& out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out += char((value >> (8 * i)) & 0xff);
+    }
+}
+
+inline void append_double(std::string& out, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    append_fixed64(out, bits);
+}
+
+inline uint64_t zigzag_encode(int64_t value) {
+    return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t value) {
+    return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+
+// Reads from [*position, end), advancing *position; false if the input ends
+// (or the varint runs on) first.
+inline bool read_varint(char const** position, char const* end, uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; *position < end && shift < 64; shift += 7) {
+        uint8_t byte = uint8_t(*(*position)++);
+        *value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline uint64_t read_fixed64(char const* position) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= uint64_t(uint8_t(position[i])) << (8 * i);
+    }
+    return value;
+}
+
+inline bool read_double(char const** position, char const* end, double* value) {
+    if (end - *position < 8) {
+        return false;
+    }
+    uint64_t bits = read_fixed64(*position);
+    memcpy(value, &bits, sizeof(bits));
+    *position += 8;
+    return true;
+}
+
+}
+
+} }
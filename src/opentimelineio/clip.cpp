@@ -11,6 +11,11 @@ Clip::Clip(std::string const& name,
     set_media_reference(media_reference);
 }
 
+Clip::Clip(Clip const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _media_reference(cloner.clone(source._media_reference)) {
+}
+
 Clip::~Clip() {
 }
 
@@ -21,6 +26,7 @@ MediaReference* Clip::media_reference() const {
 
 void  Clip::set_media_reference(MediaReference* media_reference) {
     _media_reference = media_reference ? media_reference : new MissingReference;
+    _timing_changed();
 }
 
 
@@ -20,6 +20,8 @@ public:
          optional<TimeRange> const& source_range = nullopt,
          AnyDictionary const& metadata = AnyDictionary());
 
+    Clip(Clip const& source, Cloner& cloner);
+
     void set_media_reference(MediaReference* media_reference);
 
     MediaReference* media_reference() const;
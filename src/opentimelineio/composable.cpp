@@ -1,7 +1,11 @@
 #include "opentimelineio/composable.h"
 #include "opentimelineio/composition.h"
 
+#include <atomic>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
+
+static std::atomic<uint64_t> _last_timing_stamp { 0 };
     
 Composable::Composable(std::string const& name,
                        AnyDictionary const& metadata)
@@ -9,6 +13,11 @@ Composable::Composable(std::string const& name,
       _parent(nullptr) {
 }
 
+Composable::Composable(Composable const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _parent(nullptr) {
+}
+
 Composable::~Composable() {
 }
 
@@ -37,6 +46,17 @@ Composable* Composable::_highest_ancestor() {
     return c;
 }
 
+void Composable::_timing_changed() {
+    if (_parent) {
+        // finding our index would cost as much as the rescan it saves
+        _parent->_child_timing_changed(0);
+    }
+}
+
+uint64_t Composable::_new_timing_stamp() {
+    return ++_last_timing_stamp;
+}
+
 bool Composable::read_from(Reader& reader) {
     return Parent::read_from(reader);
 }
@@ -3,6 +3,8 @@
 #include "opentimelineio/version.h"
 #include "opentimelineio/serializableObjectWithMetadata.h"
 
+#include <atomic>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
 class Composition;
@@ -19,6 +21,8 @@ public:
     Composable(std::string const& name = std::string(),
                AnyDictionary const& metadata = AnyDictionary());
 
+    Composable(Composable const& source, Cloner& cloner);
+
     virtual bool visible() const;
     virtual bool overlapping() const;
 
@@ -32,6 +36,14 @@ protected:
     bool _set_parent(Composition*);
     Composable* _highest_ancestor();
 
+    // Let our parent know that our duration may have changed, so that
+    // any ranges it has cached for its children get recomputed.
+    void _timing_changed();
+
+    // A number never handed out before, for marking what a cache of timings
+    // was worked out from.
+    static uint64_t _new_timing_stamp();
+
     Composable const* _highest_ancestor() const {
         return const_cast<Composable*>(this)->_highest_ancestor();
     }
@@ -43,6 +55,11 @@ protected:
 
 private:
     Composition* _parent;
+
+    // Where Composition::index_of_child() last found us among our parent's
+    // children.  Only a hint: it is checked before use.
+    mutable std::atomic<int> _index_in_parent { -1 };
+
     friend class Composition;
 };
 
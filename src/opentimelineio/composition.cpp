@@ -2,6 +2,7 @@
 #include "opentimelineio/vectorIndexing.h"
 
 #include <assert.h>
+#include <mutex>
 #include <set>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
@@ -15,7 +16,19 @@ Composition::Composition(std::string const& name,
 {
 }
 
+Composition::Composition(Composition const& source, Cloner& cloner)
+    : Parent(source, cloner) {
+    for (auto const& child: source.children()) {
+        Retainer<Composable> copy = cloner.clone(child);
+        if (copy && copy.value->_set_parent(this)) {
+            _child_set.insert(copy.value);
+            _children.push_back(std::move(copy));
+        }
+    }
+}
+
 Composition::~Composition() {
+    delete _unparsed_children.exchange(nullptr);
     clear_children();
 }
 
@@ -26,16 +39,19 @@ std::string const& Composition::composition_kind() const {
 
 void 
 Composition::clear_children() {
+    _decode_children();
     for (Composable* child: _children) {
         child->_set_parent(nullptr);
     }
 
     _children.clear();
     _child_set.clear();
+    _child_timing_changed(0);
 }
 
 bool 
 Composition::set_children(std::vector<Composable*> const& children, ErrorStatus* error_status) {
+    _decode_children();
     for (auto child : children) {
         if (child->parent()) {
             *error_status = ErrorStatus::CHILD_ALREADY_PARENTED;
@@ -49,11 +65,13 @@ Composition::set_children(std::vector<Composable*> const& children, ErrorStatus*
 
     _children = decltype(_children)(children.begin(), children.end());
     _child_set = std::set<Composable*>(children.begin(), children.end());
+    _child_timing_changed(0);
     return true;
 }
 
 bool 
 Composition::insert_child(int index, Composable* child, ErrorStatus* error_status) {
+    _decode_children();
     if (child->parent()) {
         *error_status = ErrorStatus::CHILD_ALREADY_PARENTED;
         return false;
@@ -63,18 +81,22 @@ Composition::insert_child(int index, Composable* child, ErrorStatus* error_statu
         
     index = adjusted_vector_index(index, _children);
     if (index >= int(_children.size())) {
+        index = int(_children.size());
         _children.emplace_back(child);
     }
     else {
-        _children.insert(_children.begin() + std::max(index, 0), child);
+        index = std::max(index, 0);
+        _children.insert(_children.begin() + index, child);
     }
 
     _child_set.insert(child);
+    _child_timing_changed(index);
     return true;
 }
 
 bool 
 Composition::set_child(int index, Composable* child, ErrorStatus* error_status) {
+    _decode_children();
     index = adjusted_vector_index(index, _children);
     if (index < 0 || index >= int(_children.size())) {
         *error_status = ErrorStatus::ILLEGAL_INDEX;
@@ -92,12 +114,14 @@ Composition::set_child(int index, Composable* child, ErrorStatus* error_status)
         child->_set_parent(this);
         _children[index] = child;
         _child_set.insert(child);
+        _child_timing_changed(index);
     }
     return true;
 }
 
 bool 
 Composition::remove_child(int index, ErrorStatus* error_status) {
+    _decode_children();
     if (_children.empty()) {
         *error_status = ErrorStatus::ILLEGAL_INDEX;
         return false;
@@ -108,6 +132,7 @@ Composition::remove_child(int index, ErrorStatus* error_status) {
     _child_set.erase(_children[index]);
     
     if (size_t(index) >= _children.size()) {
+        index = int(_children.size()) - 1;
         _children.back().value->_set_parent(nullptr);
         _children.pop_back();
     }
@@ -117,11 +142,21 @@ Composition::remove_child(int index, ErrorStatus* error_status) {
         _children.erase(_children.begin() + index);
     }
 
+    _child_timing_changed(index);
     return true;
 }
 
 
 bool Composition::read_from(Reader& reader) {
+    UnparsedJSON unparsed;
+    if (reader.read_unparsed("children", &unparsed)) {
+        if (!Parent::read_from(reader)) {
+            return false;
+        }
+        _unparsed_children.store(new UnparsedJSON(std::move(unparsed)), std::memory_order_release);
+        return true;
+    }
+
     if (reader.read("children", &_children) &&
         Parent::read_from(reader)) {
         for (Composable* child : _children) {
@@ -130,11 +165,74 @@ bool Composition::read_from(Reader& reader) {
                 return false;
             }
         }
+        _child_timing_changed(0);
     }
     return true;
 }
 
+/*
+ * Decodes children that a lazy load left as JSON text.  It's too late by now
+ * to report errors an eager load would have failed on (the JSON was only
+ * skimmed to find where it ends), so whatever can't be decoded into a child
+ * is kept back as an error for writing or cloning us to report, rather than
+ * being quietly left out.
+ */
+void Composition::_decode_unparsed_children() {
+    // Threads wanting them at the same time all wait for the first to
+    // decode them.
+    std::call_once(_children_decoded, [this] {
+        UnparsedJSON* unparsed = _unparsed_children.load(std::memory_order_relaxed);
+        if (!unparsed) {
+            return;
+        }
+
+        any decoded;
+        ErrorStatus error_status;
+        if (!unparsed->decode(&decoded, &error_status)) {
+            _set_undecodable(error_status);
+        }
+        else if (decoded.type() != typeid(AnyVector)) {
+            _set_undecodable(ErrorStatus(ErrorStatus::TYPE_MISMATCH,
+                                         string_printf("children read from line %d aren't a list",
+                                                       unparsed->line_number),
+                                         this));
+        }
+        else {
+            for (auto& e: any_cast<AnyVector&>(decoded)) {
+                Composable* child = nullptr;
+                if (e.type() == typeid(SerializableObject::Retainer<>)) {
+                    child = dynamic_cast<Composable*>(any_cast<SerializableObject::Retainer<>&>(e).value);
+                }
+
+                if (!child) {
+                    _set_undecodable(ErrorStatus(ErrorStatus::TYPE_MISMATCH,
+                                                 string_printf("children read from line %d include "
+                                                               "something that isn't a composable",
+                                                               unparsed->line_number),
+                                                 this));
+                }
+                else if (!child->_set_parent(this)) {
+                    _set_undecodable(ErrorStatus(ErrorStatus::CHILD_ALREADY_PARENTED,
+                                                 string_printf("children read from line %d",
+                                                               unparsed->line_number),
+                                                 this));
+                }
+                else {
+                    _children.emplace_back(child);
+                    _child_set.insert(child);
+                }
+            }
+        }
+
+        // Nothing has been edited, so there's no _child_timing_changed() to make:
+        // no one can have timed the children before they were there to time.
+        _unparsed_children.store(nullptr, std::memory_order_release);
+        delete unparsed;
+    });
+}
+
 void Composition::write_to(Writer& writer) const {
+    _decode_children();
     Parent::write_to(writer);
     writer.write("children", _children);
 }
@@ -161,12 +259,26 @@ Composition::handles_of_child(Composable const* /* child */, ErrorStatus* /* err
 }
 
 int Composition::index_of_child(Composable const* child, ErrorStatus* error_status) const {
+    _decode_children();
+    int index = child->_index_in_parent.load(std::memory_order_relaxed);
+    if (_is_child_at(child, index)) {
+        return index;
+    }
+
+    /*
+     * An edit has moved it, or it has never been looked for.  Renumbering
+     * all the children at once, rather than searching for just this one,
+     * keeps a lookup of each child in turn after an edit linear overall.
+     */
     for (size_t i = 0; i < _children.size(); i++) {
-        if (_children[i].value == child) {
-            return int(i);
-        }
+        _children[i].value->_index_in_parent.store(int(i), std::memory_order_relaxed);
     }
-    
+
+    index = child->_index_in_parent.load(std::memory_order_relaxed);
+    if (_is_child_at(child, index)) {
+        return index;
+    }
+
     *error_status = ErrorStatus::NOT_A_CHILD_OF;
     error_status->object_details = this;
     return -1;
@@ -293,13 +405,14 @@ optional<TimeRange> Composition::trimmed_range_of_child(Composable const* child,
     return TimeRange(new_start_time, new_duration);
 }
 
-std::vector<Composable*> Composition::_children_at_time(RationalTime t, ErrorStatus* error_status) const {
-    std::vector<Composable*> result;
+std::vector<int> Composition::_child_indices_at_time(RationalTime search_time,
+                                                     ErrorStatus* error_status) const {
+    _decode_children();
+    std::vector<int> result;
     
-    // range_of_child_at_index is O(i), so this loop is quadratic:
     for (size_t i = 0; i < _children.size() && !(*error_status); i++) {
-        if (range_of_child_at_index(int(i), error_status).contains(t)) {
-            result.push_back(_children[i].value);
+        if (range_of_child_at_index(int(i), error_status).contains(search_time)) {
+            result.push_back(int(i));
 
             if (!_overlaping_children())
                 break;
@@ -309,6 +422,97 @@ std::vector<Composable*> Composition::_children_at_time(RationalTime t, ErrorSta
     return result;
 }
 
+std::vector<int> Composition::_child_indices_in_range(TimeRange search_range,
+                                                      ErrorStatus* error_status) const {
+    _decode_children();
+    std::vector<int> result;
+    
+    for (size_t i = 0; i < _children.size() && !(*error_status); i++) {
+        if (range_of_child_at_index(int(i), error_status).intersects(search_range)) {
+            result.push_back(int(i));
+        }
+    }
+    
+    return result;
+}
+
+/*
+ * Maps a time in our space into the space of the composition at index, one
+ * level of what Item::transformed_time() does.
+ */
+static RationalTime _time_in_child(Composition const* composition, int index, RationalTime time,
+                                   ErrorStatus* error_status) {
+    auto child = dynamic_cast<Composition*>(composition->children()[index].value);
+    time -= composition->range_of_child_at_index(index, error_status).start_time();
+    if (*error_status) {
+        return time;
+    }
+    return time + child->trimmed_range(error_status).start_time();
+}
+
+std::vector<Composable::Retainer<Composable>>
+Composition::children_at_time(RationalTime search_time, ErrorStatus* error_status,
+                              bool shallow_search) const {
+    std::vector<Retainer<Composable>> result;
+    
+    for (int index: _child_indices_at_time(search_time, error_status)) {
+        if (*error_status) {
+            break;
+        }
+
+        Composable* child = children()[index];
+        result.push_back(child);
+        
+        if (auto composition = dynamic_cast<Composition*>(child)) {
+            if (shallow_search) {
+                continue;
+            }
+
+            auto child_time = _time_in_child(this, index, search_time, error_status);
+            if (*error_status) {
+                break;
+            }
+
+            auto found = composition->children_at_time(child_time, error_status, false);
+            result.insert(result.end(), found.begin(), found.end());
+        }
+    }
+    
+    return result;
+}
+
+std::vector<Composable::Retainer<Composable>>
+Composition::children_in_range(TimeRange search_range, ErrorStatus* error_status,
+                               bool shallow_search) const {
+    std::vector<Retainer<Composable>> result;
+    
+    for (int index: _child_indices_in_range(search_range, error_status)) {
+        if (*error_status) {
+            break;
+        }
+
+        Composable* child = children()[index];
+        result.push_back(child);
+        
+        if (auto composition = dynamic_cast<Composition*>(child)) {
+            if (shallow_search) {
+                continue;
+            }
+
+            auto child_start = _time_in_child(this, index, search_range.start_time(), error_status);
+            if (*error_status) {
+                break;
+            }
+
+            auto found = composition->children_in_range(TimeRange(child_start, search_range.duration()),
+                                                        error_status, false);
+            result.insert(result.end(), found.begin(), found.end());
+        }
+    }
+    
+    return result;
+}
+
 optional<TimeRange> Composition::trim_child_range(TimeRange child_range) const {
     if (!source_range()) {
         return child_range;
@@ -336,6 +540,7 @@ optional<TimeRange> Composition::trim_child_range(TimeRange child_range) const {
 }
 
 bool Composition::has_child(Composable* child) const {
+    _decode_children();
     return _child_set.find(child) != _child_set.end();
 }
 
@@ -344,5 +549,12 @@ bool Composition::_overlaping_children() const {
     return true;
 }
 
+void Composition::_child_timing_changed(int /* index */) {
+    _children_timing_stamp = _new_timing_stamp();
+
+    // our duration may follow from our children's
+    _timing_changed();
+}
+
 
 } }
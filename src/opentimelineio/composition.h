@@ -2,6 +2,8 @@
 
 #include "opentimelineio/version.h"
 #include "opentimelineio/item.h"
+#include <atomic>
+#include <mutex>
 #include <set>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
@@ -21,9 +23,12 @@ public:
                 std::vector<Effect*> const& effects = std::vector<Effect*>(),
                 std::vector<Marker*> const& markers = std::vector<Marker*>());
 
+    Composition(Composition const& source, Cloner& cloner);
+
     virtual std::string const& composition_kind() const;
 
     std::vector<Retainer<Composable>> const& children() const {
+        _decode_children();
         return _children;
     }
 
@@ -38,7 +43,7 @@ public:
     bool remove_child(int index, ErrorStatus* error_status);
 
     bool append_child(Composable* child, ErrorStatus* error_status) {
-        return insert_child(int(_children.size()), child, error_status);
+        return insert_child(int(children().size()), child, error_status);
     }
 
     bool is_parent_of(Composable const* other) const;
@@ -61,6 +66,17 @@ public:
 
     int index_of_child(Composable const* child, ErrorStatus* error_status) const;
 
+    // Children whose range contains (resp. intersects) the given time (range),
+    // which is in our own space, in order.  Unless shallow_search is set, each
+    // composition found is followed by the matching children within it.
+    std::vector<Retainer<Composable>> children_at_time(RationalTime search_time,
+                                                       ErrorStatus* error_status,
+                                                       bool shallow_search = false) const;
+
+    std::vector<Retainer<Composable>> children_in_range(TimeRange search_range,
+                                                        ErrorStatus* error_status,
+                                                        bool shallow_search = false) const;
+
 protected:
     virtual ~Composition();
 
@@ -69,18 +85,54 @@ protected:
 
     std::vector<Composition*> _path_from_child(Composable const* child, ErrorStatus* error_status) const;
     
-    // When false, will short-circut _children_at_time to return a vector of one item
+    // When false, will short-circut _child_indices_at_time to return a vector of one item
     virtual bool _overlaping_children() const;
 
+    // The indices of the children found by children_at_time() and
+    // children_in_range().  These check every child; subclasses that can
+    // narrow the search down override them.
+    virtual std::vector<int> _child_indices_at_time(RationalTime search_time,
+                                                    ErrorStatus* error_status) const;
+    virtual std::vector<int> _child_indices_in_range(TimeRange search_range,
+                                                     ErrorStatus* error_status) const;
+
+    // Called whenever the timing of the children from index onwards may have
+    // changed (children inserted, removed or replaced, or a child's duration
+    // changed).  Subclasses caching child ranges override this to drop the
+    // stale part of their cache, and must call up to this implementation,
+    // which passes the change on to our own parent.
+    virtual void _child_timing_changed(int index);
+
 private:
-    // XXX: python implementation is O(n^2) in number of children
-    std::vector<Composable*> _children_at_time(RationalTime, ErrorStatus* error_status) const;
+    // Anything touching _children must call this first, in case a lazy load
+    // left them undecoded.
+    void _decode_children() const {
+        if (_unparsed_children.load(std::memory_order_acquire)) {
+            const_cast<Composition*>(this)->_decode_unparsed_children();
+        }
+    }
+
+    void _decode_unparsed_children();
+
+    bool _is_child_at(Composable const* child, int index) const {
+        return index >= 0 && index < int(_children.size()) && _children[index].value == child;
+    }
 
     std::vector<Retainer<Composable>> _children;
+    std::atomic<UnparsedJSON*> _unparsed_children { nullptr };
+    std::once_flag _children_decoded;
     
     // This is for fast lookup only, and varies automatically
     // as _children is mutated.
     std::set<Composable*> _child_set;
+
+    // Replaced by a new stamp whenever _child_timing_changed() is, so that
+    // children can tell whether the offsets they cached relative to us are
+    // still good.
+    std::atomic<uint64_t> _children_timing_stamp { _new_timing_stamp() };
+
+    friend class Composable;
+    friend class Item;
 };
 
 } }
@@ -0,0 +1,368 @@
+#include "opentimelineio/compression.h"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(OTIO_ZLIB_SUPPORT)
+#include <zlib.h>
+#endif
+
+#if defined(OTIO_ZSTD_SUPPORT)
+#include <zstd.h>
+#endif
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
+
+static size_t const _chunk_size = 262144;
+
+// zlib counts in 32 bits, so anything bigger is passed to it in pieces
+static size_t const _max_zlib_input = size_t(1) << 30;
+
+static bool _ends_with(std::string const& s, std::string const& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+Compression compression_for_file_name(std::string const& file_name) {
+    if (_ends_with(file_name, ".gz")) {
+        return Compression::gzip;
+    }
+    if (_ends_with(file_name, ".zst")) {
+        return Compression::zstd;
+    }
+    return Compression::none;
+}
+
+Compression compression_of(char const* data, size_t size) {
+    unsigned char const* bytes = reinterpret_cast<unsigned char const*>(data);
+    if (size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b) {
+        return Compression::gzip;
+    }
+    if (size >= 4 && bytes[0] == 0x28 && bytes[1] == 0xb5 && bytes[2] == 0x2f && bytes[3] == 0xfd) {
+        return Compression::zstd;
+    }
+    return Compression::none;
+}
+
+bool compression_supported(Compression compression) {
+    switch (compression) {
+    case Compression::none:
+        return true;
+    case Compression::gzip:
+#if defined(OTIO_ZLIB_SUPPORT)
+        return true;
+#else
+        return false;
+#endif
+    case Compression::zstd:
+#if defined(OTIO_ZSTD_SUPPORT)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+char const* compression_name(Compression compression) {
+    switch (compression) {
+    case Compression::none:
+        return "uncompressed";
+    case Compression::gzip:
+        return "gzip";
+    case Compression::zstd:
+        return "zstd";
+    }
+    return "unknown";
+}
+
+size_t decompressed_size_hint(Compression compression, char const* data, size_t size) {
+    if (compression == Compression::gzip && size >= 18) {
+        // the trailer has the size modulo 2^32, and only of the last member
+        unsigned char const* trailer = reinterpret_cast<unsigned char const*>(data + size - 4);
+        return size_t(trailer[0]) | size_t(trailer[1]) << 8 |
+               size_t(trailer[2]) << 16 | size_t(trailer[3]) << 24;
+    }
+
+#if defined(OTIO_ZSTD_SUPPORT)
+    if (compression == Compression::zstd) {
+        unsigned long long frame_size = ZSTD_getFrameContentSize(data, size);
+        if (frame_size != ZSTD_CONTENTSIZE_UNKNOWN && frame_size != ZSTD_CONTENTSIZE_ERROR) {
+            return size_t(frame_size);
+        }
+    }
+#endif
+    return 0;
+}
+
+#if defined(OTIO_ZLIB_SUPPORT)
+static bool _gunzip(char const* data, size_t size,
+                    std::function<bool (char const*, size_t)> const& write_chunk,
+                    ErrorStatus* error_status) {
+    z_stream stream = z_stream();
+
+    // 32 on top of the window size takes a zlib header as well as a gzip one
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        *error_status = ErrorStatus(ErrorStatus::INTERNAL_ERROR, "could not set up zlib");
+        return false;
+    }
+
+    std::vector<char> output(_chunk_size);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    size_t remaining = size;
+    int result = Z_OK;
+
+    for (;;) {
+        if (stream.avail_in == 0 && remaining) {
+            stream.avail_in = uInt(std::min(remaining, _max_zlib_input));
+            remaining -= stream.avail_in;
+        }
+
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = uInt(output.size());
+        result = inflate(&stream, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END) {
+            break;
+        }
+
+        size_t produced = output.size() - stream.avail_out;
+        if (produced && !write_chunk(output.data(), produced)) {
+            inflateEnd(&stream);
+            return false;
+        }
+
+        if (result == Z_STREAM_END) {
+            if (stream.avail_in == 0 && remaining == 0) {
+                break;
+            }
+
+            // another member follows
+            inflateReset(&stream);
+        }
+    }
+
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        *error_status = ErrorStatus(ErrorStatus::COMPRESSION_ERROR, "gzip data is corrupt or incomplete");
+        return false;
+    }
+    return true;
+}
+#endif
+
+#if defined(OTIO_ZSTD_SUPPORT)
+static bool _unzstd(char const* data, size_t size,
+                    std::function<bool (char const*, size_t)> const& write_chunk,
+                    ErrorStatus* error_status) {
+    ZSTD_DStream* stream = ZSTD_createDStream();
+    if (!stream || ZSTD_isError(ZSTD_initDStream(stream))) {
+        ZSTD_freeDStream(stream);
+        *error_status = ErrorStatus(ErrorStatus::INTERNAL_ERROR, "could not set up zstd");
+        return false;
+    }
+
+    std::vector<char> output(ZSTD_DStreamOutSize());
+    ZSTD_inBuffer input = { data, size, 0 };
+    size_t result = 0;
+    bool more = true;
+
+    // a full output buffer may mean there is more to come even with no input left
+    while (more) {
+        ZSTD_outBuffer out = { output.data(), output.size(), 0 };
+        result = ZSTD_decompressStream(stream, &out, &input);
+        if (ZSTD_isError(result)) {
+            break;
+        }
+
+        if (out.pos && !write_chunk(output.data(), out.pos)) {
+            ZSTD_freeDStream(stream);
+            return false;
+        }
+        more = (input.pos < input.size || out.pos == out.size);
+    }
+
+    ZSTD_freeDStream(stream);
+    if (result != 0) {
+        *error_status = ErrorStatus(ErrorStatus::COMPRESSION_ERROR, "zstd data is corrupt or incomplete");
+        return false;
+    }
+    return true;
+}
+#endif
+
+bool decompress(Compression compression, char const* data, size_t size,
+                std::function<bool (char const* data, size_t size)> const& write_chunk,
+                ErrorStatus* error_status) {
+    switch (compression) {
+    case Compression::none:
+        return write_chunk(data, size);
+#if defined(OTIO_ZLIB_SUPPORT)
+    case Compression::gzip:
+        return _gunzip(data, size, write_chunk, error_status);
+#endif
+#if defined(OTIO_ZSTD_SUPPORT)
+    case Compression::zstd:
+        return _unzstd(data, size, write_chunk, error_status);
+#endif
+    default:
+        *error_status = ErrorStatus(ErrorStatus::NOT_IMPLEMENTED,
+                                    std::string("this build can't read ") +
+                                    compression_name(compression) + " compressed data");
+        return false;
+    }
+}
+
+struct Compressor::_State {
+    Compression compression;
+    std::function<bool (char const*, size_t)> write_chunk;
+    std::vector<char> output;
+    bool failed = false;
+#if defined(OTIO_ZLIB_SUPPORT)
+    z_stream zlib = z_stream();
+#endif
+#if defined(OTIO_ZSTD_SUPPORT)
+    ZSTD_CStream* zstd = nullptr;
+#endif
+};
+
+Compressor::Compressor(Compression compression,
+                       std::function<bool (char const* data, size_t size)> const& write_chunk)
+    : _state(new _State) {
+    _state->compression = compression;
+    _state->write_chunk = write_chunk;
+
+    switch (compression) {
+    case Compression::none:
+        break;
+#if defined(OTIO_ZLIB_SUPPORT)
+    case Compression::gzip:
+        _state->output.resize(_chunk_size);
+        // 16 on top of the window size writes a gzip header and trailer
+        _state->failed = (deflateInit2(&_state->zlib, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                                       15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK);
+        break;
+#endif
+#if defined(OTIO_ZSTD_SUPPORT)
+    case Compression::zstd:
+        _state->output.resize(ZSTD_CStreamOutSize());
+        _state->zstd = ZSTD_createCStream();
+        _state->failed = (!_state->zstd || ZSTD_isError(ZSTD_initCStream(_state->zstd, 3)));
+        break;
+#endif
+    default:
+        _state->failed = true;
+        break;
+    }
+}
+
+Compressor::~Compressor() {
+    switch (_state->compression) {
+#if defined(OTIO_ZLIB_SUPPORT)
+    case Compression::gzip:
+        deflateEnd(&_state->zlib);
+        break;
+#endif
+#if defined(OTIO_ZSTD_SUPPORT)
+    case Compression::zstd:
+        ZSTD_freeCStream(_state->zstd);
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+#if defined(OTIO_ZLIB_SUPPORT)
+static bool _deflate(z_stream& stream, std::vector<char>& output, int flush,
+                     std::function<bool (char const*, size_t)> const& write_chunk) {
+    int result;
+    do {
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = uInt(output.size());
+        result = deflate(&stream, flush);
+        if (result == Z_STREAM_ERROR) {
+            return false;
+        }
+
+        size_t produced = output.size() - stream.avail_out;
+        if (produced && !write_chunk(output.data(), produced)) {
+            return false;
+        }
+    } while (stream.avail_out == 0);
+
+    return flush != Z_FINISH || result == Z_STREAM_END;
+}
+#endif
+
+bool Compressor::write(char const* data, size_t size) {
+    _State& s = *_state;
+    if (s.failed) {
+        return false;
+    }
+
+    switch (s.compression) {
+    case Compression::none:
+        s.failed = !s.write_chunk(data, size);
+        break;
+#if defined(OTIO_ZLIB_SUPPORT)
+    case Compression::gzip:
+        while (size && !s.failed) {
+            size_t piece = std::min(size, _max_zlib_input);
+            s.zlib.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            s.zlib.avail_in = uInt(piece);
+            s.failed = !_deflate(s.zlib, s.output, Z_NO_FLUSH, s.write_chunk);
+            data += piece;
+            size -= piece;
+        }
+        break;
+#endif
+#if defined(OTIO_ZSTD_SUPPORT)
+    case Compression::zstd: {
+        ZSTD_inBuffer input = { data, size, 0 };
+        while (input.pos < input.size && !s.failed) {
+            ZSTD_outBuffer out = { s.output.data(), s.output.size(), 0 };
+            s.failed = (ZSTD_isError(ZSTD_compressStream(s.zstd, &out, &input)) ||
+                        (out.pos && !s.write_chunk(s.output.data(), out.pos)));
+        }
+        break;
+    }
+#endif
+    default:
+        s.failed = true;
+        break;
+    }
+    return !s.failed;
+}
+
+bool Compressor::finish() {
+    _State& s = *_state;
+    if (s.failed) {
+        return false;
+    }
+
+    switch (s.compression) {
+#if defined(OTIO_ZLIB_SUPPORT)
+    case Compression::gzip:
+        s.zlib.next_in = nullptr;
+        s.zlib.avail_in = 0;
+        s.failed = !_deflate(s.zlib, s.output, Z_FINISH, s.write_chunk);
+        break;
+#endif
+#if defined(OTIO_ZSTD_SUPPORT)
+    case Compression::zstd: {
+        size_t remaining;
+        do {
+            ZSTD_outBuffer out = { s.output.data(), s.output.size(), 0 };
+            remaining = ZSTD_endStream(s.zstd, &out);
+            s.failed = (ZSTD_isError(remaining) ||
+                        (out.pos && !s.write_chunk(s.output.data(), out.pos)));
+        } while (remaining && !s.failed);
+        break;
+    }
+#endif
+    default:
+        break;
+    }
+    return !s.failed;
+}
+
+} }
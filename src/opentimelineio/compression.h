@@ -0,0 +1,68 @@
+#pragma once
+
+#include "opentimelineio/version.h"
+#include "opentimelineio/errorStatus.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
+
+/*
+ * The compressed forms that JSON files can be written and read in.  gzip is
+ * available if zlib was found when building (with OTIO_COMPRESSION), and zstd
+ * only if asked for (with OTIO_ZSTD_SUPPORT).  Files are recognized by their
+ * first few bytes when read, and by their extension when written.
+ */
+enum class Compression {
+    none,
+    gzip,
+    zstd
+};
+
+// gzip for names ending in .gz, zstd for .zst, and none otherwise.
+Compression compression_for_file_name(std::string const& file_name);
+
+// Whatever data starts with the magic bytes of.
+Compression compression_of(char const* data, size_t size);
+
+bool compression_supported(Compression compression);
+
+char const* compression_name(Compression compression);
+
+// How big data decompresses to, as recorded in it, or 0 if it doesn't say.
+size_t decompressed_size_hint(Compression compression, char const* data, size_t size);
+
+// Hands data on to write_chunk decompressed, a chunk at a time.  Fails if
+// write_chunk returns false, or with COMPRESSION_ERROR if data is corrupt.
+// gzip data may be several members one after another (as from concatenating
+// .gz files), which decompress to their contents one after another; anything
+// else after the last member is taken to be corruption.
+bool decompress(Compression compression, char const* data, size_t size,
+                std::function<bool (char const* data, size_t size)> const& write_chunk,
+                ErrorStatus* error_status);
+
+/*
+ * Compresses what is written to it, handing the result on to write_chunk.
+ * Nothing is complete until finish() is called.
+ */
+class Compressor {
+public:
+    Compressor(Compression compression,
+               std::function<bool (char const* data, size_t size)> const& write_chunk);
+    ~Compressor();
+
+    Compressor(Compressor const&) = delete;
+    Compressor& operator=(Compressor const&) = delete;
+
+    bool write(char const* data, size_t size);
+    bool finish();
+
+private:
+    struct _State;
+    std::unique_ptr<_State> _state;
+};
+
+} }
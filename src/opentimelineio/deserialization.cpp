@@ -1,16 +1,68 @@
 #include "opentimelineio/serializableObject.h"
 #include "opentimelineio/serializableObjectWithMetadata.h"
+#include "opentimelineio/binaryFormat.h"
+#include "opentimelineio/compression.h"
 #include "opentime/rationalTime.h"
 #include "opentime/timeRange.h"
 #include "opentime/timeTransform.h"
 
 #define RAPIDJSON_NAMESPACE OTIO_rapidjson
-#include <rapidjson/filereadstream.h>
-#include <rapidjson/cursorstreamwrapper.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/reader.h>
 #include <rapidjson/error/en.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
+
+// Finds the bracket closing the array or object opened at data[begin] (or
+// size if there isn't one), just by keeping track of strings and nesting.
+static size_t _find_closing_bracket(char const* data, size_t size, size_t begin) {
+    int depth = 0;
+    bool in_string = false;
+    for (size_t i = begin; i < size; i++) {
+        char c = data[i];
+        if (in_string) {
+            if (c == '\\') {
+                i++;
+            }
+            else if (c == '"') {
+                in_string = false;
+            }
+        }
+        else if (c == '"') {
+            in_string = true;
+        }
+        else if (c == '[' || c == '{') {
+            depth++;
+        }
+        else if ((c == ']' || c == '}') && --depth == 0) {
+            return i;
+        }
+    }
+    return size;
+}
     
 class JSONDecoder : public OTIO_rapidjson::BaseReaderHandler<OTIO_rapidjson::UTF8<>, JSONDecoder> {
 public:
@@ -51,6 +103,9 @@ public:
     bool Double(double d) { return store(any(d)); }
 
     bool String(const char* str, OTIO_rapidjson::SizeType length, bool /* copy */) {
+        if (!_stack.empty() && _begin_value_schema(_stack.back(), str, length)) {
+            return true;
+        }
         return store(any(std::string(str, length)));
     }
 
@@ -64,7 +119,15 @@ public:
             return false;
         }
 
-        _stack.back().cur_key = std::string(str, length);
+        auto& top = _stack.back();
+        if (top.value_schema != _ValueSchema::none) {
+            top.cur_slot = _value_schema_slot(top.value_schema, str, length);
+            if (top.cur_slot < 0) {
+                _end_value_schema(top);
+            }
+        }
+
+        top.cur_key.assign(str, length);
         return true;
     }
 
@@ -73,6 +136,10 @@ public:
             return false;
         }
 
+        if (_lazy_source && _begin_unparsed(false /* is_dict */)) {
+            return true;
+        }
+
         _stack.emplace_back(_DictOrArray { false /* is_dict*/ });
         return true;
     }
@@ -82,6 +149,10 @@ public:
             return false;
         }
 
+        if (_lazy_source && _begin_unparsed(true /* is_dict */)) {
+            return true;
+        }
+
         _stack.emplace_back(_DictOrArray { true /* is_dict*/ });
         return true;
     }
@@ -100,10 +171,20 @@ public:
                 _internal_error("RapidJSONDecoder::_handle_end_array() called without matching _handle_start_array()");
                 _stack.pop_back();
             }
+            else if (top.unparsed_begin != std::string::npos) {
+                _end_unparsed();
+            }
             else {
                 AnyVector va;
                 va.swap(top.array);
+                bool has_forward_references = top.has_forward_references;
                 _stack.pop_back();
+                _note_forward_references(has_forward_references);
+
+                if (_root_children && _stack.size() == 1 && _stack.back().cur_key == "children") {
+                    va.swap(*_root_children);
+                    _root_children = nullptr;
+                }
                 store(any(std::move(va)));
             }
 
@@ -125,12 +206,44 @@ public:
                 _internal_error("JSONDecoder::_handle_end_object() called without matching _handle_start_object");
                 _stack.pop_back();
             }
+            else if (top.unparsed_begin != std::string::npos) {
+                _end_unparsed();
+            }
+            else if (top.value_schema != _ValueSchema::none && _decode_value_schema(top)) {
+                any a(std::move(top.slots[0]));
+                _stack.pop_back();
+                store(std::move(a));
+            }
             else {
+                _end_value_schema(top);
+
                 // when we end a dictionary, we immediately convert it
                 // to the type it really represents, if it is a schema object.
+                // Unless it refers to an object we haven't seen yet, a schema
+                // object is read in straight away too, so that its dictionary
+                // can be freed now rather than held until finalize().
+                bool has_forward_references = top.has_forward_references;
                 SerializableObject::Reader reader(top.dict, _error_function, nullptr, static_cast<int>(_line_number_function()));
-                _stack.pop_back();                
-                store(reader._decode(_resolver));
+                _stack.pop_back();
+                any a = reader._decode(_resolver, !has_forward_references);
+
+                if (a.type() == typeid(SerializableObject::ReferenceId)) {
+                    auto e = _resolver.object_for_id.find(any_cast<SerializableObject::ReferenceId const&>(a).id);
+                    if (e != _resolver.object_for_id.end()) {
+                        a = any(SerializableObject::Retainer<>(e->second));
+                        has_forward_references = false;
+                    }
+                    else {
+                        has_forward_references = true;
+                    }
+                }
+                else if (a.type() == typeid(SerializableObject::Retainer<>)) {
+                    // a deferred object is resolved on its own
+                    has_forward_references = false;
+                }
+
+                _note_forward_references(has_forward_references);
+                store(std::move(a));
             }
         }
         return true;
@@ -146,16 +259,211 @@ public:
         }
         else {
             auto& top = _stack.back();
-            if (top.is_dict) {
-                top.dict.emplace(_stack.back().cur_key, a);
+            if (top.value_schema != _ValueSchema::none) {
+                // as with the dictionary, the first value for a key wins
+                if (!top.has_slot[top.cur_slot]) {
+                    top.slots[top.cur_slot] = std::move(a);
+                    top.has_slot[top.cur_slot] = true;
+                }
+            }
+            else if (top.is_dict) {
+                top.dict.emplace(std::move(top.cur_key), std::move(a));
             }
             else {
-                top.array.emplace_back(a);
+                top.array.emplace_back(std::move(a));
             }
         }
         return true;
     }
+
+    // A reference to an object that hasn't been read yet can only be
+    // resolved in finalize(), so the object containing it must wait too.
+    void _note_forward_references(bool has_forward_references) {
+        if (has_forward_references && !_stack.empty()) {
+            _stack.back().has_forward_references = true;
+        }
+    }
     
+    /*
+     * RationalTime and TimeRange values far outnumber everything else in a
+     * file, so rather than building a dictionary for each one and having
+     * Reader::_decode() pick it apart, their fields are collected straight
+     * into slots.  Anything that doesn't look exactly like what the writer
+     * produces (OTIO_SCHEMA first, then just the expected fields, of the
+     * expected types) is put back into the dictionary and decoded as usual,
+     * so errors are reported the same way either way.
+     */
+    enum class _ValueSchema { none, rational_time, time_range };
+
+    struct _DictOrArray;
+
+    static bool _equals(char const* str, size_t length, char const* literal) {
+        return length == strlen(literal) && memcmp(str, literal, length) == 0;
+    }
+
+    bool _begin_value_schema(_DictOrArray& top, char const* str, size_t length) {
+        if (!top.is_dict || !top.dict.empty() || top.value_schema != _ValueSchema::none ||
+            top.cur_key != "OTIO_SCHEMA") {
+            return false;
+        }
+
+        if (_equals(str, length, "RationalTime.1")) {
+            top.value_schema = _ValueSchema::rational_time;
+        }
+        else if (_equals(str, length, "TimeRange.1")) {
+            top.value_schema = _ValueSchema::time_range;
+        }
+        return top.value_schema != _ValueSchema::none;
+    }
+
+    static char const* _value_schema_field(_ValueSchema value_schema, int slot) {
+        static char const* rational_time_fields[] = { "rate", "value" };
+        static char const* time_range_fields[] = { "start_time", "duration" };
+        return value_schema == _ValueSchema::rational_time ? rational_time_fields[slot]
+                                                           : time_range_fields[slot];
+    }
+
+    static int _value_schema_slot(_ValueSchema value_schema, char const* str, size_t length) {
+        for (int slot = 0; slot < 2; slot++) {
+            if (_equals(str, length, _value_schema_field(value_schema, slot))) {
+                return slot;
+            }
+        }
+        return -1;
+    }
+
+    static bool _as_double(any const& a, double* d) {
+        if (a.type() == typeid(double)) {
+            *d = any_cast<double>(a);
+            return true;
+        }
+        else if (a.type() == typeid(int64_t)) {
+            *d = static_cast<double>(any_cast<int64_t>(a));
+            return true;
+        }
+        return false;
+    }
+
+    // Builds the value in slots[0] if the slots hold everything it needs.
+    static bool _decode_value_schema(_DictOrArray& top) {
+        if (!top.has_slot[0] || !top.has_slot[1]) {
+            return false;
+        }
+
+        if (top.value_schema == _ValueSchema::rational_time) {
+            double rate, value;
+            if (!_as_double(top.slots[0], &rate) || !_as_double(top.slots[1], &value)) {
+                return false;
+            }
+            top.slots[0] = any(RationalTime(value, rate));
+        }
+        else {
+            if (top.slots[0].type() != typeid(RationalTime) ||
+                top.slots[1].type() != typeid(RationalTime)) {
+                return false;
+            }
+            top.slots[0] = any(TimeRange(any_cast<RationalTime>(top.slots[0]),
+                                         any_cast<RationalTime>(top.slots[1])));
+        }
+        return true;
+    }
+
+    // Turns the slots back into an ordinary dictionary.
+    static void _end_value_schema(_DictOrArray& top) {
+        if (top.value_schema == _ValueSchema::none) {
+            return;
+        }
+
+        top.dict.emplace("OTIO_SCHEMA", std::string(top.value_schema == _ValueSchema::rational_time ?
+                                                    "RationalTime.1" : "TimeRange.1"));
+        for (int slot = 0; slot < 2; slot++) {
+            if (top.has_slot[slot]) {
+                top.dict.emplace(_value_schema_field(top.value_schema, slot), std::move(top.slots[slot]));
+            }
+        }
+        top.value_schema = _ValueSchema::none;
+    }
+
+    /*
+     * For a lazy load, the children of a composition and the metadata of an
+     * object are skipped over, by moving the stream on to the closing
+     * bracket, and kept as the JSON text to be decoded when first asked for.
+     * That is only done for objects of the version their type is registered
+     * as, so that no upgrade function sees them, and only with no object
+     * references anywhere in the input, as those couldn't be resolved.
+     */
+    void set_lazy(std::shared_ptr<void const> const& source, char const* data, size_t size,
+                  OTIO_rapidjson::MemoryStream* stream) {
+        _lazy_source = source;
+        _data = data;
+        _size = size;
+        _stream = stream;
+    }
+
+    enum { _unparsed_children = TypeRegistry::lazy_children, _unparsed_metadata = TypeRegistry::lazy_metadata };
+
+    bool _begin_unparsed(bool is_dict) {
+        if (_stack.empty() || !_stack.back().is_dict) {
+            return false;
+        }
+
+        auto& top = _stack.back();
+        int field = is_dict ? (top.cur_key == "metadata" ? _unparsed_metadata : 0)
+                            : (top.cur_key == "children" ? _unparsed_children : 0);
+        if (!field || !(_unparsed_fields(top.dict) & field)) {
+            return false;
+        }
+
+        // there's nothing to be saved by leaving an empty value unparsed
+        size_t begin = _stream->Tell() - 1;
+        size_t end = _find_closing_bracket(_data, _size, begin);
+        if (end == _size || _data + end == std::find_if(_data + begin + 1, _data + end, [](char c) {
+                return !(c == ' ' || c == '\t' || c == '\n' || c == '\r');
+            })) {
+            return false;
+        }
+
+        int line_number = static_cast<int>(_line_number_function());
+        _stream->src_ = _stream->begin_ + end;
+        _stack.emplace_back(_DictOrArray { is_dict });
+        _stack.back().unparsed_begin = begin;
+        _stack.back().unparsed_line_number = line_number;
+        return true;
+    }
+
+    void _end_unparsed() {
+        SerializableObject::UnparsedJSON unparsed;
+        unparsed.source = _lazy_source;
+        unparsed.data = _data + _stack.back().unparsed_begin;
+        unparsed.size = _stream->Tell() - _stack.back().unparsed_begin;
+        unparsed.line_number = _stack.back().unparsed_line_number;
+        _stack.pop_back();
+        store(any(std::move(unparsed)));
+    }
+
+    // Which fields objects of the schema in d are able to leave unparsed.
+    int _unparsed_fields(AnyDictionary const& d) {
+        auto schema_name_and_version = _lookup<std::string>(d, "OTIO_SCHEMA");
+        if (!schema_name_and_version) {
+            return 0;
+        }
+
+        auto e = _unparsed_fields_for_schema.find(*schema_name_and_version);
+        if (e != _unparsed_fields_for_schema.end()) {
+            return e->second;
+        }
+
+        int fields = 0;
+        std::string schema_name;
+        int schema_version;
+        if (split_schema_string(*schema_name_and_version, &schema_name, &schema_version)) {
+            fields = TypeRegistry::instance()._lazy_fields_for_schema(schema_name, schema_version);
+        }
+
+        _unparsed_fields_for_schema[*schema_name_and_version] = fields;
+        return fields;
+    }
+
     template <typename T>
     static T const* _lookup(AnyDictionary const& d, std::string const& key) {
         auto e = d.find(key);
@@ -167,6 +475,10 @@ public:
 
     any _root;
 
+    // If set, the children already decoded for the root object, to be used
+    // in place of its (empty) "children" array.
+    AnyVector* _root_children = nullptr;
+
     void _internal_error(std::string const& err_msg) {
         _error_status = ErrorStatus(ErrorStatus::INTERNAL_ERROR,
                                     string_printf("%s (near line %d)", err_msg.c_str(),
@@ -185,16 +497,34 @@ public:
         }
         
         bool is_dict;
+        bool has_forward_references = false;
         AnyDictionary dict;
         AnyVector array;
         std::string cur_key;
+
+        _ValueSchema value_schema = _ValueSchema::none;
+        int cur_slot = -1;
+        bool has_slot[2] = { false, false };
+        any slots[2];
+
+        size_t unparsed_begin = std::string::npos;
+        int unparsed_line_number = 0;
     };
 
+    // moved, not copied, when it grows
+    static_assert(std::is_nothrow_move_constructible<_DictOrArray>::value,
+                  "the open containers must move without throwing");
     std::vector<_DictOrArray> _stack;
     std::function<void (ErrorStatus const&)> _error_function;
     std::function<size_t ()> _line_number_function;
 
     SerializableObject::Reader::_Resolver _resolver;
+
+    std::shared_ptr<void const> _lazy_source;
+    char const* _data = nullptr;
+    size_t _size = 0;
+    OTIO_rapidjson::MemoryStream* _stream = nullptr;
+    std::map<std::string, int> _unparsed_fields_for_schema;
 };
 
 SerializableObject::Reader::Reader(AnyDictionary& source, error_function_t const& error_function,
@@ -281,6 +611,9 @@ bool SerializableObject::Reader::_fetch(std::string const& key, T* dest, bool* h
         _error(ErrorStatus(ErrorStatus::KEY_NOT_FOUND, key));
         return false;
     }
+    else if (!_decode_unparsed(&e->second)) {
+        return false;
+    }
     else if (e->second.type() == typeid(void) && had_null) {
         _dict.erase(e);
         *had_null = true;
@@ -309,6 +642,9 @@ bool SerializableObject::Reader::_fetch(std::string const& key, double* dest) {
         _error(ErrorStatus(ErrorStatus::KEY_NOT_FOUND, key));
         return false;
     }
+    else if (!_decode_unparsed(&e->second)) {
+        return false;
+    }
 
     if (e->second.type() == typeid(double)) {
         *dest = any_cast<double>(e->second);
@@ -339,6 +675,9 @@ bool SerializableObject::Reader::_fetch(std::string const& key, int64_t* dest) {
         _error(ErrorStatus(ErrorStatus::KEY_NOT_FOUND, key));
         return false;
     }
+    else if (!_decode_unparsed(&e->second)) {
+        return false;
+    }
 
     if (e->second.type() == typeid(int64_t)) {
         *dest = any_cast<int64_t>(e->second);
@@ -365,6 +704,9 @@ bool SerializableObject::Reader::_fetch(std::string const& key, SerializableObje
         _error(ErrorStatus(ErrorStatus::KEY_NOT_FOUND, key));
         return false;
     }
+    else if (!_decode_unparsed(&e->second)) {
+        return false;
+    }
 
     if (e->second.type() == typeid(void)) {
         *dest = nullptr;
@@ -405,7 +747,7 @@ bool SerializableObject::Reader::_type_check_so(std::type_info const& wanted, st
     return true;
 }
 
-any SerializableObject::Reader::_decode(_Resolver& resolver) {
+any SerializableObject::Reader::_decode(_Resolver& resolver, bool read_now) {
     if (_dict.find("OTIO_SCHEMA") == _dict.end()) {
         return any(std::move(_dict));
     }
@@ -469,6 +811,14 @@ any SerializableObject::Reader::_decode(_Resolver& resolver) {
             if (!ref_id.empty()) {
                 resolver.object_for_id[ref_id] = so;
             }
+
+            if (read_now) {
+                Retainer<> retainer(so);
+                Reader r(_dict, _error_function, so, _line_number);
+                so->read_from(r);
+                return any(std::move(retainer));
+            }
+
             resolver.data_for_object.emplace(so, std::move(_dict));
             resolver.line_number_for_object[so] = _line_number;
             return any(SerializableObject::Retainer<>(so));
@@ -565,6 +915,9 @@ bool SerializableObject::Reader::read(std::string const& key, any* value) {
         _error(ErrorStatus(ErrorStatus::KEY_NOT_FOUND, key));
         return false;
     }
+    else if (!_decode_unparsed(&e->second)) {
+        return false;
+    }
     else {
         value->swap(e->second);
         _dict.erase(e);
@@ -572,14 +925,357 @@ bool SerializableObject::Reader::read(std::string const& key, any* value) {
     }
 }
 
-bool deserialize_json_from_string(std::string const& input, any* destination, ErrorStatus* error_status) {
-    OTIO_rapidjson::Reader reader;
-    OTIO_rapidjson::StringStream ss(input.c_str());
-    OTIO_rapidjson::CursorStreamWrapper<decltype(ss)> csw(ss);
-    JSONDecoder handler(std::bind(&decltype(csw)::GetLine, &csw));
+bool SerializableObject::Reader::read_unparsed(std::string const& key, UnparsedJSON* dest) {
+    auto e = _dict.find(key);
+    if (e == _dict.end() || e->second.type() != typeid(UnparsedJSON)) {
+        return false;
+    }
+
+    std::swap(*dest, any_cast<UnparsedJSON&>(e->second));
+    _dict.erase(e);
+    return true;
+}
+
+// Anything reading a value left undecoded by a lazy load, other than through
+// read_unparsed(), gets it decoded.
+bool SerializableObject::Reader::_decode_unparsed(any* value) {
+    if (value->type() != typeid(UnparsedJSON)) {
+        return true;
+    }
+
+    any decoded;
+    ErrorStatus error_status;
+    if (!any_cast<UnparsedJSON const&>(*value).decode(&decoded, &error_status)) {
+        _error(error_status);
+        return false;
+    }
+    value->swap(decoded);
+    return true;
+}
+
+/*
+ * Works out line numbers for error messages from the input itself, rather
+ * than having the stream keep count a character at a time.  The decoder asks
+ * at the end of each object, each time further along, so every stretch of
+ * the input only gets counted once.  The input is found through begin each
+ * time, so it may move in between.
+ */
+class _LineCounter {
+public:
+    _LineCounter(char const* const& begin, size_t first_line = 1)
+        : _begin(begin),
+          _counted_to(0),
+          _first_line(first_line),
+          _line(first_line) {
+    }
+
+    size_t line_at(size_t offset) {
+        if (offset < _counted_to) {
+            return _first_line + std::count(_begin, _begin + offset, '\n');
+        }
+
+        _line += std::count(_begin + _counted_to, _begin + offset, '\n');
+        _counted_to = offset;
+        return _line;
+    }
+
+    size_t column_at(size_t offset) const {
+        char const* position = _begin + offset;
+        char const* line_start = position;
+        while (line_start > _begin && line_start[-1] != '\n') {
+            line_start--;
+        }
+        return size_t(position - line_start);
+    }
+
+private:
+    char const* const& _begin;
+    size_t _counted_to;
+    size_t _first_line;
+    size_t _line;
+};
+
+/*
+ * The contents of a file, mapped into memory so that it can be parsed
+ * straight out of the page cache.  Anything that can't be mapped (an empty
+ * file, a pipe) is read in instead.
+ */
+class _FileContents {
+public:
+    _FileContents() {
+    }
+
+    ~_FileContents() {
+        if (!_mapped) {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(_data);
+#else
+        munmap(const_cast<char*>(_data), _size);
+#endif
+    }
+
+    bool open(std::string const& file_name) {
+        return _map(file_name) || _read(file_name);
+    }
+
+    char const* data() const {
+        return _data;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+private:
+    bool _map(std::string const& file_name) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            // the view keeps the mapping open once it has been made
+            if (HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+                if (void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) {
+                    _data = static_cast<char const*>(view);
+                    _size = size_t(size.QuadPart);
+                    _mapped = true;
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+#else
+        int fd = ::open(file_name.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* addr = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                madvise(addr, size_t(st.st_size), MADV_SEQUENTIAL);
+                _data = static_cast<char const*>(addr);
+                _size = size_t(st.st_size);
+                _mapped = true;
+            }
+        }
+        close(fd);
+#endif
+        return _mapped;
+    }
+
+    bool _read(std::string const& file_name) {
+        FILE* fp = nullptr;
+#if defined(_WIN32)
+        if (fopen_s(&fp, file_name.c_str(), "rb") != 0)
+        {
+            fp = nullptr;
+        }
+#else
+        fp = fopen(file_name.c_str(), "rb");
+#endif
+        if (!fp) {
+            return false;
+        }
+
+        char read_buffer[65536];
+        size_t n;
+        while ((n = fread(read_buffer, 1, sizeof(read_buffer), fp)) > 0) {
+            _buffer.append(read_buffer, n);
+        }
+        fclose(fp);
+
+        _data = _buffer.data();
+        _size = _buffer.size();
+        return true;
+    }
+
+    char const* _data = nullptr;
+    size_t _size = 0;
+    bool _mapped = false;
+    std::string _buffer;
+};
+
+// bounds on how much room is first made for decompressed contents
+static size_t const _min_decompressed_capacity = 65536;
+static size_t const _max_initial_decompressed_capacity = size_t(1) << 28;
+
+/*
+ * The contents of a compressed file, decompressed on a thread of their own so
+ * that they can be parsed as they arrive.  The buffer is only ever moved to
+ * make room while the parser is waiting in wait_beyond(), which hands back
+ * where it now is.
+ */
+class _DecompressedContents {
+public:
+    _DecompressedContents(std::shared_ptr<_FileContents> const& file, Compression compression)
+        : _file(file) {
+        /*
+         * The hint is usually right, but a damaged file may claim anything
+         * (deflate can't shrink data more than about 1000 times), and a gzip
+         * file of several members only gives the size of the last.  So it is
+         * only a start, as is a guess when there is no hint, and _append()
+         * grows the buffer from there as needed.
+         */
+        size_t capacity = decompressed_size_hint(compression, file->data(), file->size());
+        if (!capacity) {
+            capacity = file->size() * 4;
+        }
+        _grow(std::max(std::min({ capacity, file->size() * 1032, _max_initial_decompressed_capacity }),
+                       _min_decompressed_capacity));
+
+        _thread = std::thread([this, compression]() {
+            ErrorStatus error_status;
+            bool status = decompress(compression, _file->data(), _file->size(),
+                                     [this](char const* data, size_t size) { return _append(data, size); },
+                                     &error_status);
+            std::lock_guard<std::mutex> lock(_mutex);
+            _finished = true;
+            _error_status = status ? ErrorStatus() : error_status;
+            _changed.notify_all();
+        });
+    }
 
-    bool status = reader.Parse<OTIO_rapidjson::kParseNanAndInfFlag>(csw, handler);
-    handler.finalize();    
+    ~_DecompressedContents() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _abandoned = true;
+            _changed.notify_all();
+        }
+        _thread.join();
+    }
+
+    // Waits for more than offset bytes to be there, or for there to be no more.
+    size_t wait_beyond(size_t offset, char const** data) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _parser_waiting = true;
+        _changed.notify_all();
+        _changed.wait(lock, [this, offset]() { return _size > offset || _finished; });
+        _parser_waiting = false;
+        *data = _data.get();
+        return _size;
+    }
+
+    // Waits for everything, returning false if it couldn't all be decompressed.
+    bool finish(ErrorStatus* error_status) {
+        char const* data;
+        wait_beyond(std::numeric_limits<size_t>::max(), &data);
+        if (_error_status) {
+            *error_status = _error_status;
+            return false;
+        }
+        return true;
+    }
+
+    // Only once finish() has returned.
+    char const* data() const {
+        return _data.get();
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+private:
+    void _grow(size_t capacity) {
+        std::unique_ptr<char[]> data(new char[capacity]);
+        if (_size) {
+            std::memcpy(data.get(), _data.get(), _size);
+        }
+        _data.swap(data);
+        _capacity = capacity;
+    }
+
+    bool _append(char const* data, size_t size) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_size + size > _capacity) {
+            _changed.wait(lock, [this]() { return _parser_waiting || _abandoned; });
+            if (!_abandoned) {
+                _grow(std::max(_capacity * 2, _size + size));
+            }
+        }
+        if (_abandoned) {
+            return false;
+        }
+
+        std::memcpy(_data.get() + _size, data, size);
+        _size += size;
+        _changed.notify_all();
+        return true;
+    }
+
+    std::shared_ptr<_FileContents> _file;
+    std::unique_ptr<char[]> _data;
+    size_t _size = 0;
+    size_t _capacity = 0;
+
+    std::mutex _mutex;
+    std::condition_variable _changed;
+    bool _parser_waiting = false;
+    bool _finished = false;
+    bool _abandoned = false;
+    ErrorStatus _error_status;
+    std::thread _thread;
+};
+
+/*
+ * A rapidjson stream reading _DecompressedContents as they come.
+ */
+class _DecompressedStream {
+public:
+    typedef char Ch;
+
+    _DecompressedStream(_DecompressedContents& contents)
+        : _contents(contents) {
+    }
+
+    Ch Peek() {
+        return (_position < _available || _wait()) ? _data[_position] : '\0';
+    }
+
+    Ch Take() {
+        return (_position < _available || _wait()) ? _data[_position++] : '\0';
+    }
+
+    size_t Tell() const {
+        return _position;
+    }
+
+    // where the contents are, as of the last wait
+    char const* const& data() const {
+        return _data;
+    }
+
+    Ch* PutBegin() { RAPIDJSON_ASSERT(false); return 0; }
+    void Put(Ch) { RAPIDJSON_ASSERT(false); }
+    void Flush() { RAPIDJSON_ASSERT(false); }
+    size_t PutEnd(Ch*) { RAPIDJSON_ASSERT(false); return 0; }
+
+private:
+    bool _wait() {
+        _available = _contents.wait_beyond(_position, &_data);
+        return _position < _available;
+    }
+
+    _DecompressedContents& _contents;
+    char const* _data = nullptr;
+    size_t _available = 0;
+    size_t _position = 0;
+};
+
+template <typename InputStream>
+static bool _parse_json(InputStream& stream, JSONDecoder& handler, _LineCounter& line_counter,
+                        any* destination, ErrorStatus* error_status) {
+    OTIO_rapidjson::Reader reader;
+    bool status = reader.Parse<OTIO_rapidjson::kParseNanAndInfFlag>(stream, handler);
+    handler.finalize();
 
     if (handler.has_errored(error_status)) {
         return false;
@@ -587,10 +1283,12 @@ bool deserialize_json_from_string(std::string const& input, any* destination, Er
 
     if (!status) {
         auto msg = GetParseError_En(reader.GetParseErrorCode());
+        size_t offset = reader.GetErrorOffset();
         *error_status = ErrorStatus(ErrorStatus::JSON_PARSE_ERROR,
                                     string_printf("JSON parse error on input string: %s "
                                                   "(line %d, column %d)",
-                                                  msg, csw.GetLine(), csw.GetColumn()));
+                                                  msg, int(line_counter.line_at(offset)),
+                                                  int(line_counter.column_at(offset))));
         return false;
     }
 
@@ -598,43 +1296,495 @@ bool deserialize_json_from_string(std::string const& input, any* destination, Er
     return true;
 }
 
-bool deserialize_json_from_file(std::string const& file_name, any* destination, ErrorStatus* error_status) {
-    FILE* fp = nullptr;
-#if defined(_WIN32)
-    if (fopen_s(&fp, file_name.c_str(), "r") != 0)
-    {
-        fp = nullptr;
+static bool _deserialize_json_from_buffer(char const* data, size_t size,
+                                          any* destination, ErrorStatus* error_status,
+                                          std::shared_ptr<void const> const& lazy_source = nullptr,
+                                          int first_line = 1, AnyVector* root_children = nullptr) {
+    ObjectArena::Scope arena_scope(ObjectArena::enabled());
+    OTIO_rapidjson::MemoryStream ms(data, size);
+    _LineCounter line_counter(data, size_t(first_line));
+    JSONDecoder handler([&ms, &line_counter]() { return line_counter.line_at(ms.Tell()); });
+    handler._root_children = root_children;
+    if (lazy_source) {
+        handler.set_lazy(lazy_source, data, size, &ms);
     }
-#else
-    fp = fopen(file_name.c_str(), "r");
-#endif
-    if (!fp) {
+
+    return _parse_json(ms, handler, line_counter, destination, error_status);
+}
+
+/*
+ * Parses the contents as they are decompressed.  Should the decompression
+ * fail, that error is the one reported, rather than whatever the parser made
+ * of the contents being cut short.
+ */
+static bool _deserialize_json_while_decompressing(_DecompressedContents& contents,
+                                                  any* destination, ErrorStatus* error_status) {
+    ObjectArena::Scope arena_scope(ObjectArena::enabled());
+    _DecompressedStream stream(contents);
+    _LineCounter line_counter(stream.data());
+    JSONDecoder handler([&stream, &line_counter]() { return line_counter.line_at(stream.Tell()); });
+
+    any result;
+    bool status = _parse_json(stream, handler, line_counter, &result, error_status);
+
+    if (!contents.finish(error_status)) {
+        return false;
+    }
+
+    if (status) {
+        destination->swap(result);
+    }
+    return status;
+}
+
+bool SerializableObject::UnparsedJSON::decode(any* destination, ErrorStatus* error_status) const {
+    return _deserialize_json_from_buffer(data, size, destination, error_status, source, line_number);
+}
+
+static bool _contains(char const* data, size_t size, char const* literal) {
+    return std::search(data, data + size, literal, literal + strlen(literal)) != data + size;
+}
+
+static bool _has_object_references(char const* data, size_t size) {
+    return _contains(data, size, "OTIO_REF_ID") || _contains(data, size, "SerializableObjectRef");
+}
+
+/*
+ * Finds where each element of the root object's "children" array starts and
+ * ends, just by keeping track of strings and nesting.  Returns false if the
+ * input doesn't have that shape.
+ */
+static bool _find_root_children(char const* data, size_t size,
+                                size_t* array_begin, size_t* array_end,
+                                std::vector<std::pair<size_t, size_t>>* elements) {
+    int depth = 0;
+    bool in_string = false;
+    size_t string_begin = 0, key_begin = 0, key_end = 0;
+    bool expect_children = false, in_children = false, in_element = false;
+    size_t element_begin = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        char c = data[i];
+        if (in_string) {
+            if (c == '\\') {
+                i++;
+            }
+            else if (c == '"') {
+                in_string = false;
+                key_begin = string_begin;
+                key_end = i;
+            }
+            continue;
+        }
+
+        bool space = (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+        if (expect_children && !space && c != '[') {
+            return false;
+        }
+        if (in_children && depth == 2 && !in_element && !space && c != ',' && c != ']') {
+            element_begin = i;
+            in_element = true;
+        }
+
+        switch (c) {
+        case '"':
+            in_string = true;
+            string_begin = i + 1;
+            break;
+        case '[':
+            if (expect_children) {
+                expect_children = false;
+                in_children = true;
+                *array_begin = i;
+            }
+            depth++;
+            break;
+        case '{':
+            depth++;
+            break;
+        case ']':
+        case '}':
+            depth--;
+            if (in_children && depth == 1) {
+                if (in_element) {
+                    elements->emplace_back(element_begin, i);
+                }
+                *array_end = i + 1;
+                return true;
+            }
+            break;
+        case ',':
+            if (in_children && depth == 2) {
+                elements->emplace_back(element_begin, i);
+                in_element = false;
+            }
+            break;
+        case ':':
+            if (depth == 1 && !in_children && key_end - key_begin == 8 &&
+                memcmp(data + key_begin, "children", 8) == 0) {
+                expect_children = true;
+            }
+            break;
+        }
+    }
+    return false;
+}
+
+/*
+ * Decodes each element of the root object's "children" array (the timelines
+ * in a SerializableCollection, say) on a thread of its own, and then the rest
+ * of the root object with those in place.  If anything fails, be it an
+ * element or the rest, the whole is decoded again serially, which reports the
+ * error (and the line it is on) exactly as it would otherwise have been.  The
+ * input mustn't use object references, as they can't be resolved between
+ * elements decoded separately.
+ */
+static bool _deserialize_json_in_parallel(char const* data, size_t size, int max_threads,
+                                          std::shared_ptr<void const> const& lazy_source,
+                                          any* destination, ErrorStatus* error_status) {
+    size_t array_begin = 0, array_end = 0;
+    std::vector<std::pair<size_t, size_t>> elements;
+    if (max_threads < 2 ||
+        !_find_root_children(data, size, &array_begin, &array_end, &elements) ||
+        elements.size() < 2) {
+        return _deserialize_json_from_buffer(data, size, destination, error_status, lazy_source);
+    }
+
+    AnyVector children(elements.size());
+    std::vector<char> failed(elements.size(), false);
+    std::atomic<size_t> next_element { 0 };
+
+    auto decode_elements = [&]() {
+        for (size_t i = next_element++; i < elements.size(); i = next_element++) {
+            ErrorStatus element_error_status;
+            failed[i] = !_deserialize_json_from_buffer(data + elements[i].first,
+                                                       elements[i].second - elements[i].first,
+                                                       &children[i], &element_error_status, lazy_source);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    int thread_count = std::min(max_threads, int(elements.size()));
+    for (int t = 1; t < thread_count; t++) {
+        threads.emplace_back(decode_elements);
+    }
+    decode_elements();
+    for (auto& t: threads) {
+        t.join();
+    }
+
+    if (std::find(failed.begin(), failed.end(), true) == failed.end()) {
+        // anything left unparsed in the rest of the root object refers to this copy
+        auto root = std::make_shared<std::string>();
+        root->reserve(size - (array_end - array_begin) + 2);
+        root->append(data, array_begin + 1);
+        root->append(data + array_end - 1, size - array_end + 1);
+
+        // its line numbers are off from the file's, so its errors are no use
+        ErrorStatus root_error_status;
+        if (_deserialize_json_from_buffer(root->data(), root->size(), destination, &root_error_status,
+                                          lazy_source ? root : nullptr, 1, &children)) {
+            return true;
+        }
+    }
+
+    children.clear();
+    return _deserialize_json_from_buffer(data, size, destination, error_status, lazy_source);
+}
+
+bool deserialize_json_from_string(std::string const& input, any* destination, ErrorStatus* error_status) {
+    return _deserialize_json_from_buffer(input.c_str(), input.size(), destination, error_status);
+}
+
+bool deserialize_json_from_file(std::string const& file_name, any* destination, ErrorStatus* error_status,
+                                int max_threads, bool lazy) {
+    auto contents = std::make_shared<_FileContents>();
+    if (!contents->open(file_name)) {
         *error_status = ErrorStatus(ErrorStatus::FILE_OPEN_FAILED, file_name);
         return false;
     }
 
-    OTIO_rapidjson::Reader reader;
+    if (max_threads <= 0) {
+        max_threads = int(std::thread::hardware_concurrency());
+    }
+
+    char const* data = contents->data();
+    size_t size = contents->size();
+    std::shared_ptr<void const> source = contents;
+
+    Compression compression = compression_of(data, size);
+    if (compression != Compression::none) {
+        if (!compression_supported(compression)) {
+            *error_status = ErrorStatus(ErrorStatus::NOT_IMPLEMENTED,
+                                        string_printf("this build can't read %s compressed files: %s",
+                                                      compression_name(compression), file_name.c_str()));
+            return false;
+        }
+
+        auto decompressed = std::make_shared<_DecompressedContents>(contents, compression);
+        if (!lazy && max_threads == 1) {
+            return _deserialize_json_while_decompressing(*decompressed, destination, error_status);
+        }
+
+        // finding the children to decode in parallel, or to skip, takes all of it
+        if (!decompressed->finish(error_status)) {
+            return false;
+        }
+        data = decompressed->data();
+        size = decompressed->size();
+        source = decompressed;
+    }
+
+    // object references can only be resolved by decoding everything in one go
+    if ((lazy || max_threads > 1) && _has_object_references(data, size)) {
+        lazy = false;
+        max_threads = 1;
+    }
+
+    std::shared_ptr<void const> lazy_source;
+    if (lazy) {
+        lazy_source = source;
+    }
+    return _deserialize_json_in_parallel(data, size, max_threads, lazy_source,
+                                         destination, error_status);
+}
+
+/*
+ * Reads the binary form laid out in binaryFormat.h, feeding what it finds to
+ * a JSONDecoder, which then builds up values just as it would from the JSON
+ * form (apart from line numbers, which there aren't any of).
+ */
+class _BinaryReader {
+public:
+    _BinaryReader(char const* data, size_t size)
+        : _data(data),
+          _end(data + size) {
+    }
+
+    bool parse(JSONDecoder& handler) {
+        return _read_header_and_trailer() && _read_value(handler) && _at_body_end();
+    }
+
+    std::string const& error() const {
+        return _error;
+    }
+
+private:
+    bool _fail(char const* what) {
+        _error = string_printf("%s (at byte %llu)", what, (unsigned long long)(_position - _data));
+        return false;
+    }
+
+    bool _read_header_and_trailer() {
+        using namespace binary_format;
+
+        size_t size = size_t(_end - _data);
+        if (size < header_size + trailer_size || memcmp(_data, magic, magic_size) != 0) {
+            _position = _data;
+            return _fail("not an OpenTimelineIO binary file");
+        }
+        if (uint8_t(_data[magic_size]) != version) {
+            _position = _data + magic_size;
+            return _fail("unsupported binary format version");
+        }
+
+        uint64_t string_table_offset = read_fixed64(_end - trailer_size);
+        if (string_table_offset < header_size || string_table_offset > size - trailer_size) {
+            _position = _end - trailer_size;
+            return _fail("bad string table offset");
+        }
+
+        _body_end = _data + string_table_offset;
+        _position = _body_end;
+        char const* trailer = _end - trailer_size;
+        uint64_t count;
+        if (!read_varint(&_position, trailer, &count) || count > uint64_t(trailer - _position)) {
+            return _fail("bad string table");
+        }
+
+        _strings.reserve(size_t(count));
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t length;
+            if (!read_varint(&_position, trailer, &length) || length > uint64_t(trailer - _position)) {
+                return _fail("bad string table");
+            }
+            _strings.emplace_back(_position, size_t(length));
+            _position += length;
+        }
+
+        // the object offsets are only there for readers seeking to objects
+        // directly, but are checked all the same
+        if (uint8_t(_data[magic_size + 1]) & has_object_offsets) {
+            uint64_t offset = 0;
+            if (!read_varint(&_position, trailer, &count)) {
+                return _fail("bad object offsets");
+            }
+            for (uint64_t i = 0; i < count; i++) {
+                uint64_t delta;
+                if (!read_varint(&_position, trailer, &delta) ||
+                    (offset += delta) >= string_table_offset || offset < header_size) {
+                    return _fail("bad object offsets");
+                }
+            }
+        }
+
+        if (_position != trailer) {
+            return _fail("unexpected data before the end of the input");
+        }
+
+        _position = _data + header_size;
+        return true;
+    }
 
-    char readBuffer[65536];
-    OTIO_rapidjson::FileReadStream fs(fp, readBuffer, sizeof(readBuffer));
-    OTIO_rapidjson::CursorStreamWrapper<decltype(fs)> csw(fs);
-    JSONDecoder handler(std::bind(&decltype(csw)::GetLine, &csw));
+    bool _at_body_end() {
+        return _position == _body_end || _fail("unexpected data after the root value");
+    }
+
+    bool _read_varint(uint64_t* value) {
+        return binary_format::read_varint(&_position, _body_end, value) || _fail("truncated input");
+    }
 
-    bool status = reader.Parse<OTIO_rapidjson::kParseNanAndInfFlag>(csw, handler);
-    fclose(fp);
+    bool _read_double(double* value) {
+        return binary_format::read_double(&_position, _body_end, value) || _fail("truncated input");
+    }
 
+    bool _read_doubles(double* values, int count) {
+        for (int i = 0; i < count; i++) {
+            if (!_read_double(&values[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Arrays and objects are read recursively, so how deeply they can nest is
+    // limited, to keep malformed input from overflowing the stack.
+    static constexpr int _max_depth = 1000;
+
+    bool _enter_container() {
+        return ++_depth <= _max_depth || _fail("arrays and objects nested too deeply");
+    }
+
+    bool _read_table_string(std::string const** value) {
+        uint64_t index;
+        if (!_read_varint(&index)) {
+            return false;
+        }
+        if (index >= _strings.size()) {
+            return _fail("bad string table index");
+        }
+        *value = &_strings[size_t(index)];
+        return true;
+    }
+
+    bool _read_value(JSONDecoder& handler) {
+        using namespace binary_format;
+
+        if (_position == _body_end) {
+            return _fail("truncated input");
+        }
+
+        char const* tag_position = _position;
+        uint64_t u;
+        double d[4];
+        std::string const* s = nullptr;
+
+        switch (uint8_t(*_position++)) {
+        case null:
+            return handler.Null();
+        case false_value:
+            return handler.Bool(false);
+        case true_value:
+            return handler.Bool(true);
+        case integer:
+            return _read_varint(&u) && handler.Int64(zigzag_decode(u));
+        case unsigned_integer:
+            return _read_varint(&u) && handler.Uint64(u);
+        case number:
+            return _read_double(d) && handler.Double(d[0]);
+        case string:
+            if (!_read_varint(&u)) {
+                return false;
+            }
+            if (u > uint64_t(_body_end - _position)) {
+                return _fail("truncated input");
+            }
+            _position += u;
+            return handler.String(_position - u, OTIO_rapidjson::SizeType(u), false);
+        case table_string:
+            return _read_table_string(&s) &&
+                handler.String(s->c_str(), OTIO_rapidjson::SizeType(s->size()), false);
+        case rational_time:
+            return _read_doubles(d, 2) && handler.store(any(RationalTime(d[0], d[1])));
+        case time_range:
+            return _read_doubles(d, 4) &&
+                handler.store(any(TimeRange(RationalTime(d[0], d[1]), RationalTime(d[2], d[3]))));
+        case time_transform:
+            return _read_doubles(d, 4) &&
+                handler.store(any(TimeTransform(RationalTime(d[0], d[1]), d[2], d[3])));
+        case array:
+            if (!_enter_container() || !_read_varint(&u) || !handler.StartArray()) {
+                return false;
+            }
+            for (uint64_t i = 0; i < u; i++) {
+                if (!_read_value(handler)) {
+                    return false;
+                }
+            }
+            _depth--;
+            return handler.EndArray(OTIO_rapidjson::SizeType(u));
+        case object:
+            if (!_enter_container() || !handler.StartObject()) {
+                return false;
+            }
+            while (true) {
+                if (!_read_varint(&u)) {
+                    return false;
+                }
+                if (u == 0) {
+                    break;
+                }
+                if (u > _strings.size()) {
+                    return _fail("bad string table index");
+                }
+                s = &_strings[size_t(u - 1)];
+                if (!handler.Key(s->c_str(), OTIO_rapidjson::SizeType(s->size()), false) ||
+                    !_read_value(handler)) {
+                    return false;
+                }
+            }
+            _depth--;
+            return handler.EndObject(0);
+        default:
+            _position = tag_position;
+            return _fail("unknown value tag");
+        }
+    }
+
+    char const* _data;
+    char const* _end;
+    char const* _body_end = nullptr;
+    char const* _position = nullptr;
+    std::vector<std::string> _strings;
+    std::string _error;
+    int _depth = 0;
+};
+
+static bool _deserialize_binary_from_buffer(char const* data, size_t size,
+                                            any* destination, ErrorStatus* error_status) {
+    ObjectArena::Scope arena_scope(ObjectArena::enabled());
+    _BinaryReader reader(data, size);
+    JSONDecoder handler([]() { return size_t(0); });
+
+    bool status = reader.parse(handler);
     handler.finalize();
-    
+
     if (handler.has_errored(error_status)) {
         return false;
     }
-    
+
     if (!status) {
-        auto msg = GetParseError_En(reader.GetParseErrorCode());
-        *error_status = ErrorStatus(ErrorStatus::JSON_PARSE_ERROR,
-                                    string_printf("JSON parse error on input string: %s "
-                                                  "(line %d, column %d)",
-                                                  msg, csw.GetLine(), csw.GetColumn()));
+        *error_status = ErrorStatus(ErrorStatus::BINARY_PARSE_ERROR, reader.error());
         return false;
     }
 
@@ -642,4 +1792,18 @@ bool deserialize_json_from_file(std::string const& file_name, any* destination,
     return true;
 }
 
+bool deserialize_binary_from_string(std::string const& input, any* destination, ErrorStatus* error_status) {
+    return _deserialize_binary_from_buffer(input.data(), input.size(), destination, error_status);
+}
+
+bool deserialize_binary_from_file(std::string const& file_name, any* destination, ErrorStatus* error_status) {
+    _FileContents contents;
+    if (!contents.open(file_name)) {
+        *error_status = ErrorStatus(ErrorStatus::FILE_OPEN_FAILED, file_name);
+        return false;
+    }
+
+    return _deserialize_binary_from_buffer(contents.data(), contents.size(), destination, error_status);
+}
+
 } }
@@ -10,6 +10,27 @@ namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
 bool deserialize_json_from_string(std::string const& input, any* destination, ErrorStatus* error_status); 
 
-bool deserialize_json_from_file(std::string const& file_name, any* destination, ErrorStatus* error_status);
+// gzip and zstd compressed files are decompressed as they are read, if this
+// build supports them (see compression.h); without lazy or max_threads set,
+// they are parsed as they are decompressed.
+//
+// With max_threads other than 1, the children of the root object (the
+// timelines of a SerializableCollection, say) are decoded in parallel by up to
+// that many threads; 0 means one per core.  Any schema types registered from
+// Python must then not be read while the caller holds the GIL.
+//
+// With lazy set, the children of compositions and the metadata of objects are
+// left undecoded until they are first asked for, so that just the outline of
+// a large file can be looked at quickly.  The file is kept open until then.
+// Those parts are only skimmed until they are decoded, so errors in them
+// aren't reported here: whatever is in error is missing from the objects, and
+// writing or cloning them fails with the error instead.
+bool deserialize_json_from_file(std::string const& file_name, any* destination, ErrorStatus* error_status,
+                                int max_threads = 1, bool lazy = false);
+
+// Decodes the binary form written by serialize_binary_to_string().
+bool deserialize_binary_from_string(std::string const& input, any* destination, ErrorStatus* error_status);
+
+bool deserialize_binary_from_file(std::string const& file_name, any* destination, ErrorStatus* error_status);
     
 } }
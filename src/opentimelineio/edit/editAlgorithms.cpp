@@ -129,7 +129,13 @@ Intersections get_intersections(
     Intersections intersections;
     bool contact = false;
 
-    for (int idx = 0; idx < children.size(); idx++) {
+    // Only the children the track's index says can overlap need looking at
+    auto bounds = track->child_index_bounds(track_range, error_status);
+    if (*error_status) {
+        return {};
+    }
+
+    for (int idx = bounds.first; idx <= bounds.second; idx++) {
         RetainedComposable const& composable = children[idx];
 
         // FIXME: Handle transitions
@@ -10,6 +10,11 @@ Effect::Effect(std::string const& name,
       _effect_name(effect_name) {
 }
 
+Effect::Effect(Effect const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _effect_name(source._effect_name) {
+}
+
 Effect::~Effect() {
 }
 
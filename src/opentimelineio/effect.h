@@ -18,6 +18,8 @@ public:
            std::string const& effect_name = std::string(),
            AnyDictionary const& metadata = AnyDictionary());
 
+    Effect(Effect const& source, Cloner& cloner);
+
     std::string const& effect_name() const {
         return _effect_name;
     }
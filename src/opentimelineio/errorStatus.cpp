@@ -54,6 +54,10 @@ std::string ErrorStatus::outcome_to_string(Outcome o) {
         return "cannot trim transition";
     case INVALID_EXECUTION_ORDER:
         return "invalid execution order";
+    case BINARY_PARSE_ERROR:
+        return "binary parse error";
+    case COMPRESSION_ERROR:
+        return "compressed data is corrupt";
     default:
         return "unknown/illegal ErrorStatus::Outcome code";
     };
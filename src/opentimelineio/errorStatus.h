@@ -39,6 +39,8 @@ struct ErrorStatus {
         CANNOT_TRIM_TRANSITION,
         OBJECT_CYCLE,
         INVALID_EXECUTION_ORDER,
+        BINARY_PARSE_ERROR,
+        COMPRESSION_ERROR,
     };
 
     ErrorStatus()
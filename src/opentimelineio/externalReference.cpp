@@ -9,6 +9,11 @@ ExternalReference::ExternalReference(std::string const& target_url,
       _target_url(target_url) {
 }
 
+ExternalReference::ExternalReference(ExternalReference const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _target_url(source._target_url) {
+}
+
 ExternalReference::~ExternalReference() {
 }
 
@@ -17,6 +17,8 @@ public:
     ExternalReference(std::string const& target_url = std::string(),
                       optional<TimeRange> const& available_range = nullopt,
                       AnyDictionary const& metadata = AnyDictionary());
+
+    ExternalReference(ExternalReference const& source, Cloner& cloner);
         
     std::string const& target_url() const {
         return _target_url;
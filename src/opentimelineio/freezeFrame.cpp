@@ -7,6 +7,10 @@ FreezeFrame::FreezeFrame(std::string const& name,
     : Parent(name, "FreezeFrame", 0.0, metadata) {
 }
 
+FreezeFrame::FreezeFrame(FreezeFrame const& source, Cloner& cloner)
+    : Parent(source, cloner) {
+}
+
 FreezeFrame::~FreezeFrame() {
 }
 
@@ -17,6 +17,8 @@ public:
     FreezeFrame(std::string const& name = std::string(),
                 AnyDictionary const& metadata = AnyDictionary());
 
+    FreezeFrame(FreezeFrame const& source, Cloner& cloner);
+
 protected:
     virtual ~FreezeFrame();
 
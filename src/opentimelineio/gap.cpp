@@ -19,6 +19,10 @@ Gap::Gap(RationalTime duration,
              metadata, effects, markers) {
 }
 
+Gap::Gap(Gap const& source, Cloner& cloner)
+    : Parent(source, cloner) {
+}
+
 Gap::~Gap() {
 }
 
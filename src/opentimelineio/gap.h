@@ -27,6 +27,8 @@ public:
         std::vector<Marker*> const& markers = std::vector<Marker*>(),         
         AnyDictionary const& metadata = AnyDictionary());
 
+    Gap(Gap const& source, Cloner& cloner);
+
     virtual bool visible() const;
 
 protected:
@@ -12,6 +12,12 @@ GeneratorReference::GeneratorReference(std::string const& name,
       _parameters(parameters) {
 }
 
+GeneratorReference::GeneratorReference(GeneratorReference const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _generator_kind(source._generator_kind),
+      _parameters(cloner.clone(source._parameters)) {
+}
+
 GeneratorReference::~GeneratorReference() {
 }
 
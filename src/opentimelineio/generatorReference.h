@@ -19,6 +19,8 @@ public:
                        optional<TimeRange> const& available_range = nullopt,
                        AnyDictionary const& parameters = AnyDictionary(),
                        AnyDictionary const& metadata = AnyDictionary());
+
+    GeneratorReference(GeneratorReference const& source, Cloner& cloner);
         
     std::string const& generator_kind() const {
         return _generator_kind;
@@ -23,6 +23,18 @@ ImageSequenceReference::ImageSequenceReference(std::string const& target_url_bas
     _missing_frame_policy {missing_frame_policy} {
     }
 
+    ImageSequenceReference::ImageSequenceReference(ImageSequenceReference const& source, Cloner& cloner)
+    : Parent(source, cloner),
+    _target_url_base(source._target_url_base),
+    _name_prefix(source._name_prefix),
+    _name_suffix(source._name_suffix),
+    _start_frame {source._start_frame},
+    _frame_step {source._frame_step},
+    _rate {source._rate},
+    _frame_zero_padding {source._frame_zero_padding},
+    _missing_frame_policy {source._missing_frame_policy} {
+    }
+
     ImageSequenceReference::~ImageSequenceReference() {
     }
 
@@ -30,6 +30,8 @@ public:
                       MissingFramePolicy const missing_frame_policy = MissingFramePolicy::error,
                       optional<TimeRange> const& available_range = nullopt,
                       AnyDictionary const& metadata = AnyDictionary());
+
+    ImageSequenceReference(ImageSequenceReference const& source, Cloner& cloner);
         
     std::string const& target_url_base() const {
         return _target_url_base;
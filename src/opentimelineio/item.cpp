@@ -2,8 +2,11 @@
 #include "opentimelineio/composition.h"
 #include "opentimelineio/effect.h"
 #include "opentimelineio/marker.h"
+#include "opentimelineio/mediaReference.h"
 
 #include <assert.h>
+#include <cstdint>
+#include <mutex>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
@@ -19,6 +22,13 @@ Item::Item(std::string const& name,
 {
 }
 
+Item::Item(Item const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _source_range(source._source_range),
+      _effects(cloner.clone(source._effects)),
+      _markers(cloner.clone(source._markers)) {
+}
+
 Item::~Item() {
 }
 
@@ -30,6 +40,11 @@ bool Item::overlapping() const {
     return false;
 }
 
+void Item::set_source_range(optional<TimeRange> const& source_range) {
+    _source_range = source_range;
+    _timing_changed();
+}
+
 RationalTime Item::duration(ErrorStatus* error_status) const {
     return trimmed_range(error_status).duration();
 }
@@ -76,41 +91,125 @@ TimeRange Item::range_in_parent(ErrorStatus* error_status) const {
     return parent()->range_of_child(this, error_status);
 }
 
+/*
+ * Items cache their offsets in their parent and their transform to the root,
+ * and threads may ask for them at once.  A mutex each would double the size
+ * of a small clip, so they share a handful, picked by address, instead.
+ * None is held while another is taken.
+ */
+static std::mutex& _timing_mutex(Item const* item) {
+    static std::mutex mutexes[64];
+    return mutexes[(reinterpret_cast<uintptr_t>(item) / sizeof(Item)) % 64];
+}
+
+bool Item::_start_times(RationalTime* start_in_self, RationalTime* start_in_parent,
+                        ErrorStatus* error_status) const {
+    auto parent = this->parent();
+    uint64_t parent_stamp = parent->_children_timing_stamp;
+    uint64_t media_generation = MediaReference::available_range_generation();
+    {
+        std::lock_guard<std::mutex> lock(_timing_mutex(this));
+        if (_timing_cache.parent_stamp == parent_stamp &&
+            _timing_cache.media_generation == media_generation) {
+            *start_in_self = _timing_cache.start_in_self;
+            *start_in_parent = _timing_cache.start_in_parent;
+            return true;
+        }
+    }
+
+    *start_in_self = trimmed_range(error_status).start_time();
+    if (*error_status) {
+        return false;
+    }
+
+    int index = parent->index_of_child(this, error_status);
+    if (*error_status) {
+        return false;
+    }
+
+    *start_in_parent = parent->range_of_child_at_index(index, error_status).start_time();
+    if (*error_status) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_timing_mutex(this));
+    _timing_cache.parent_stamp = parent_stamp;
+    _timing_cache.media_generation = media_generation;
+    _timing_cache.start_in_self = *start_in_self;
+    _timing_cache.start_in_parent = *start_in_parent;
+    _timing_cache.transform_stamp = 0;
+    return true;
+}
+
+TimeTransform Item::_transform_to_root(uint64_t* stamp, ErrorStatus* error_status) const {
+    auto parent = this->parent();
+    if (!parent) {
+        *stamp = 0;
+        return TimeTransform();
+    }
+
+    /*
+     * Checked from the root down, since a change to the offsets of any of
+     * our ancestors only shows in the stamp of that ancestor's parent.
+     */
+    uint64_t parent_transform_stamp;
+    auto parent_transform = parent->_transform_to_root(&parent_transform_stamp, error_status);
+    if (*error_status) {
+        return TimeTransform();
+    }
+
+    RationalTime start_in_self, start_in_parent;
+    if (!_start_times(&start_in_self, &start_in_parent, error_status)) {
+        return TimeTransform();
+    }
+
+    std::lock_guard<std::mutex> lock(_timing_mutex(this));
+    if (!_timing_cache.transform_stamp ||
+        _timing_cache.parent_transform_stamp != parent_transform_stamp) {
+        _timing_cache.transform_to_root = parent_transform.applied_to(
+            TimeTransform(start_in_parent - start_in_self));
+        _timing_cache.parent_transform_stamp = parent_transform_stamp;
+        _timing_cache.transform_stamp = _new_timing_stamp();
+    }
+    *stamp = _timing_cache.transform_stamp;
+    return _timing_cache.transform_to_root;
+}
+
+TimeTransform Item::transform_to_root(ErrorStatus* error_status) const {
+    uint64_t stamp;
+    return _transform_to_root(&stamp, error_status);
+}
+
 RationalTime Item::transformed_time(RationalTime time, Item const* to_item, ErrorStatus* error_status) const {
     if (!to_item) {
         return time;
     }
     
     auto root = _highest_ancestor();
-    auto item = this;
+    Item const* item = this;
     auto result = time;
+    RationalTime start_in_self, start_in_parent;
     
     while (item != root && item != to_item) {
-        auto parent = item->parent();
-        result -= item->trimmed_range(error_status).start_time();
-        if (*error_status) {
+        if (!item->_start_times(&start_in_self, &start_in_parent, error_status)) {
             return result;
         }
         
-        result += parent->range_of_child(item, error_status).start_time();
-        item = parent;
+        result -= start_in_self;
+        result += start_in_parent;
+        item = item->parent();
     }
         
     auto ancestor = item;
     item = to_item;
     while (item != root && item != ancestor) {
-        auto parent = item->parent();
-        result += item->trimmed_range(error_status).start_time();
-        if (*error_status) {
+        if (!item->_start_times(&start_in_self, &start_in_parent, error_status)) {
             return result;
         }
         
-        result -= parent->range_of_child(item, error_status).start_time();
-        if (*error_status) {
-            return result;
-        }
-
-        item = parent;
+        result += start_in_self;
+        result -= start_in_parent;
+        item = item->parent();
     }
     
     assert(item == ancestor);
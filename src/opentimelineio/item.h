@@ -26,6 +26,8 @@ public:
          std::vector<Effect*> const& effects = std::vector<Effect*>(),
          std::vector<Marker*> const& markers = std::vector<Marker*>());
 
+    Item(Item const& source, Cloner& cloner);
+
     virtual bool visible() const;
     virtual bool overlapping() const;
 
@@ -33,9 +35,7 @@ public:
         return _source_range;
     }
 
-    void set_source_range(optional<TimeRange> const& source_range) {
-        _source_range = source_range;
-    }
+    void set_source_range(optional<TimeRange> const& source_range);
 
     std::vector<Retainer<Effect>>& effects() {
         return _effects;
@@ -67,6 +67,14 @@ public:
     
     TimeRange range_in_parent(ErrorStatus* error_status) const;
     
+    // Maps times in our space into the space of our highest ancestor.  It is
+    // worked out once, from our parent's, and kept until the timing of
+    // something it follows from changes.  Where rates are mixed, times mapped
+    // with it (or with the transforms of two items) may differ in the last
+    // bits from what transformed_time() gives, which adds up the offsets
+    // level by level.
+    TimeTransform transform_to_root(ErrorStatus* error_status) const;
+
     RationalTime transformed_time(RationalTime time, Item const* to_item, ErrorStatus* error_status) const;
     
     TimeRange transformed_time_range(TimeRange time_range, Item const* to_item, ErrorStatus* error_status) const;
@@ -81,6 +89,36 @@ private:
     optional<TimeRange> _source_range;
     std::vector<Retainer<Effect>> _effects;
     std::vector<Retainer<Marker>> _markers;
+
+    // Our trimmed start time, and our start time in our parent, each of
+    // which is kept until our parent's children change.
+    bool _start_times(RationalTime* start_in_self, RationalTime* start_in_parent,
+                      ErrorStatus* error_status) const;
+
+    // transform_to_root(), and a stamp to tell whether it has been worked
+    // out afresh since a child last used it (0 at the root, where it never
+    // changes).
+    TimeTransform _transform_to_root(uint64_t* stamp, ErrorStatus* error_status) const;
+
+    /*
+     * What the two functions above last worked out, and what from: our
+     * parent's _children_timing_stamp, and MediaReference's
+     * available_range_generation() (media references can't tell the clips
+     * using them of changes, so any change to any of them counts).  Guarded
+     * by a mutex shared with a few other items; see item.cpp.
+     */
+    struct _TimingCache {
+        uint64_t parent_stamp = 0;
+        uint64_t media_generation = 0;
+        RationalTime start_in_self;
+        RationalTime start_in_parent;
+
+        // 0 if the transform isn't worked out yet
+        uint64_t transform_stamp = 0;
+        uint64_t parent_transform_stamp = 0;
+        TimeTransform transform_to_root;
+    };
+    mutable _TimingCache _timing_cache;
 };
 
 } }
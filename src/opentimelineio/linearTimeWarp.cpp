@@ -10,6 +10,11 @@ LinearTimeWarp::LinearTimeWarp(std::string const& name,
       _time_scalar(time_scalar) {
 }
 
+LinearTimeWarp::LinearTimeWarp(LinearTimeWarp const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _time_scalar(source._time_scalar) {
+}
+
 LinearTimeWarp::~LinearTimeWarp() {
 }
 
@@ -19,6 +19,8 @@ public:
                    double time_scalar = 1,
                    AnyDictionary const& metadata = AnyDictionary());
 
+    LinearTimeWarp(LinearTimeWarp const& source, Cloner& cloner);
+
     double time_scalar() const {
         return _time_scalar;
     }
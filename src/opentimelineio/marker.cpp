@@ -12,6 +12,12 @@ Marker::Marker(std::string const& name,
       _marked_range(marked_range) {
 }
 
+Marker::Marker(Marker const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _color(source._color),
+      _marked_range(source._marked_range) {
+}
+
 Marker::~Marker() {
 }
 
@@ -33,6 +33,8 @@ public:
            std::string const& color = Color::green,
            AnyDictionary const& metadata = AnyDictionary());
 
+    Marker(Marker const& source, Cloner& cloner);
+
     std::string const& color() const {
         return _color;
     }
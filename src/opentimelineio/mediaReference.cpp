@@ -1,6 +1,10 @@
 #include "opentimelineio/mediaReference.h"
 
+#include <atomic>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
+
+static std::atomic<uint64_t> _available_range_generation { 0 };
     
 MediaReference::MediaReference(std::string const& name,
                                optional<TimeRange> const& available_range,
@@ -9,10 +13,24 @@ MediaReference::MediaReference(std::string const& name,
       _available_range(available_range) {
 }
 
+MediaReference::MediaReference(MediaReference const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _available_range(source._available_range) {
+}
+
 MediaReference::~MediaReference() {
 }
 
 
+void MediaReference::set_available_range(optional<TimeRange> const& available_range) {
+    _available_range = available_range;
+    ++_available_range_generation;
+}
+
+uint64_t MediaReference::available_range_generation() {
+    return _available_range_generation;
+}
+
 bool MediaReference::is_missing_reference() const {
     return false;
 }
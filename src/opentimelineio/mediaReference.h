@@ -20,15 +20,21 @@ public:
                    optional<TimeRange> const& available_range = nullopt,
                    AnyDictionary const& metadata = AnyDictionary());
 
+    MediaReference(MediaReference const& source, Cloner& cloner);
+
     optional<TimeRange> const& available_range () const {
         return _available_range;
     }
 
-    void set_available_range(optional<TimeRange> const& available_range) {
-        _available_range = available_range;
-    }
+    void set_available_range(optional<TimeRange> const& available_range);
 
     virtual bool is_missing_reference() const;
+
+    // Bumped whenever the available range of any media reference changes.
+    // A media reference doesn't know which clips refer to it, so anything
+    // caching durations that may come from an available range (e.g. Track)
+    // compares against this to know when to throw its cache away.
+    static uint64_t available_range_generation();
     
 protected:
     virtual ~MediaReference();
@@ -8,6 +8,10 @@ MissingReference::MissingReference(std::string const& name,
     : Parent(name, available_range, metadata) {
 }
 
+MissingReference::MissingReference(MissingReference const& source, Cloner& cloner)
+    : Parent(source, cloner) {
+}
+
 MissingReference::~MissingReference() {
 }
 
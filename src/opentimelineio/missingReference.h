@@ -18,6 +18,8 @@ public:
                      optional<TimeRange> const& available_range = nullopt,
                      AnyDictionary const& metadata = AnyDictionary());
 
+    MissingReference(MissingReference const& source, Cloner& cloner);
+
     virtual bool is_missing_reference() const;
 
 protected:
@@ -0,0 +1,153 @@
+#include "opentimelineio/objectArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
+
+static std::atomic<bool> _enabled { false };
+
+static size_t const _alignment = alignof(std::max_align_t);
+static size_t const _first_block_size = 4096;
+static size_t const _max_block_size = 65536;
+
+// Anything bigger is allocated on its own.
+static size_t const _max_object_size = _max_block_size / 4;
+
+static size_t _round_up(size_t size) {
+    return (size + _alignment - 1) & ~(_alignment - 1);
+}
+
+/*
+ * A block counts one reference for each object still in it, and one more
+ * while a Scope may still allocate from it.
+ */
+struct _ArenaBlock {
+    std::atomic<size_t> references;
+    char* next;
+    char* end;
+};
+
+/*
+ * Each object is preceded by a header saying which block it is in, if any, so
+ * that deallocate() can tell without looking the object up, or locking.
+ */
+struct _ObjectHeader {
+    _ArenaBlock* block;
+};
+
+static size_t const _header_size = _alignment;
+static_assert(sizeof(_ObjectHeader) <= _alignment, "an object header must fit in front of an aligned object");
+
+static std::atomic<size_t> _live_blocks { 0 };
+
+struct _ArenaThreadState {
+    bool active = false;
+    _ArenaBlock* block = nullptr;
+    size_t block_size = _first_block_size;
+};
+
+static thread_local _ArenaThreadState _thread_state;
+
+static char* _block_start(_ArenaBlock* block) {
+    return reinterpret_cast<char*>(block) + _round_up(sizeof(_ArenaBlock));
+}
+
+static void _release(_ArenaBlock* block) {
+    if (--block->references == 0) {
+        --_live_blocks;
+        block->~_ArenaBlock();
+        ::operator delete(block);
+    }
+}
+
+static _ArenaBlock* _new_block(size_t size) {
+    void* memory = ::operator new(_round_up(sizeof(_ArenaBlock)) + size);
+    _ArenaBlock* block = new (memory) _ArenaBlock;
+    block->references = 1;
+    block->next = _block_start(block);
+    block->end = block->next + size;
+    ++_live_blocks;
+    return block;
+}
+
+void ObjectArena::set_enabled(bool enabled) {
+    _enabled = enabled;
+}
+
+bool ObjectArena::enabled() {
+    return _enabled;
+}
+
+size_t ObjectArena::live_blocks() {
+    return _live_blocks;
+}
+
+ObjectArena::Scope::Scope(bool active)
+    : _active(active) {
+    if (_active) {
+        _ArenaThreadState& state = _thread_state;
+        _saved_active = state.active;
+        _saved_block = state.block;
+        _saved_block_size = state.block_size;
+        state.active = true;
+        state.block = nullptr;
+        state.block_size = _first_block_size;
+    }
+}
+
+ObjectArena::Scope::~Scope() {
+    if (_active) {
+        _ArenaThreadState& state = _thread_state;
+        if (state.block) {
+            _release(state.block);
+        }
+        state.active = _saved_active;
+        state.block = static_cast<_ArenaBlock*>(_saved_block);
+        state.block_size = _saved_block_size;
+    }
+}
+
+void* ObjectArena::allocate(size_t size) {
+    _ArenaThreadState& state = _thread_state;
+    if (!state.active || size > _max_object_size) {
+        char* memory = static_cast<char*>(::operator new(_header_size + size));
+        reinterpret_cast<_ObjectHeader*>(memory)->block = nullptr;
+        return memory + _header_size;
+    }
+
+    size = _header_size + _round_up(size);
+    _ArenaBlock* block = state.block;
+    if (!block || size_t(block->end - block->next) < size) {
+        if (block) {
+            _release(block);
+        }
+        block = state.block = _new_block(std::max(state.block_size, size));
+        if (state.block_size < _max_block_size) {
+            state.block_size *= 2;
+        }
+    }
+
+    char* memory = block->next;
+    block->next += size;
+    ++block->references;
+    reinterpret_cast<_ObjectHeader*>(memory)->block = block;
+    return memory + _header_size;
+}
+
+void ObjectArena::deallocate(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+
+    char* memory = static_cast<char*>(pointer) - _header_size;
+    if (_ArenaBlock* block = reinterpret_cast<_ObjectHeader*>(memory)->block) {
+        _release(block);
+    }
+    else {
+        ::operator delete(memory);
+    }
+}
+
+} }
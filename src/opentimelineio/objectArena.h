@@ -0,0 +1,54 @@
+#pragma once
+
+#include "opentimelineio/version.h"
+
+#include <cstddef>
+
+namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
+
+/*
+ * Optional block allocation for SerializableObjects.
+ *
+ * While a Scope is active on a thread, the objects created on that thread are
+ * carved one after another out of shared blocks, rather than each being
+ * allocated on its own.  Objects are still deleted one at a time, whenever
+ * Retainer or possibly_delete() says so, but a block's memory is only
+ * released once every object in it is gone: an object that outlives the rest
+ * of its graph keeps its whole block alive.
+ *
+ * Once enabled (it is off by default; from Python, through
+ * otio.core.set_object_arena_enabled()), deserialization and
+ * SerializableObject::clone() create their objects in blocks of their own.
+ */
+class ObjectArena {
+public:
+    static void set_enabled(bool enabled);
+    static bool enabled();
+
+    // The blocks still holding objects, or that a Scope may allocate from.
+    static size_t live_blocks();
+
+    // Objects created on this thread while a Scope is active come from blocks
+    // that only this Scope allocates from; an inactive Scope does nothing.
+    class Scope {
+    public:
+        explicit Scope(bool active = true);
+        ~Scope();
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        bool _active;
+        void* _saved_block;
+        size_t _saved_block_size;
+        bool _saved_active;
+    };
+
+    // Memory from allocate(), whether or not a Scope was active, must only
+    // be given back through deallocate().
+    static void* allocate(size_t size);
+    static void deallocate(void* pointer);
+};
+
+} }
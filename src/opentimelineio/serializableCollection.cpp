@@ -10,6 +10,11 @@ SerializableCollection::SerializableCollection(std::string const& name,
       _children(children.begin(), children.end()) {
 }
 
+SerializableCollection::SerializableCollection(SerializableCollection const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _children(cloner.clone(source._children)) {
+}
+
 SerializableCollection::~SerializableCollection() {
 }
 
@@ -18,6 +18,8 @@ public:
                            std::vector<SerializableObject*> children = std::vector<SerializableObject*>(),
                            AnyDictionary const& metadata = AnyDictionary());
 
+    SerializableCollection(SerializableCollection const& source, Cloner& cloner);
+
     std::vector<Retainer<SerializableObject>> const& children() const {
         return _children;
     }
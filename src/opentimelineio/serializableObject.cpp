@@ -4,30 +4,67 @@
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
+struct SerializableObject::_Extras {
+    std::mutex mutex;
+    std::function<void ()> external_keepalive_monitor;
+    AnyDictionary dynamic_fields;
+    ErrorStatus undecodable;
+};
+
 SerializableObject::SerializableObject()
-    : _cached_type_record(nullptr) {
-    _managed_ref_count = 0;
+    : _cached_type_record(nullptr),
+      _extras(nullptr),
+      _managed_ref_count(0) {
+}
+
+SerializableObject::SerializableObject(SerializableObject const& source, Cloner& cloner)
+    : _cached_type_record(nullptr),
+      _extras(nullptr),
+      _managed_ref_count(0) {
+    _Extras* source_extras = source._extras.load(std::memory_order_acquire);
+    if (source_extras && !source_extras->dynamic_fields.empty()) {
+        dynamic_fields() = cloner.clone(source_extras->dynamic_fields);
+    }
 }
 
 SerializableObject::~SerializableObject() {
+    delete _extras.load(std::memory_order_acquire);
+}
+
+SerializableObject::_Extras* SerializableObject::_extras_or_create() {
+    _Extras* extras = _extras.load(std::memory_order_acquire);
+    if (!extras) {
+        _Extras* created = new _Extras;
+        if (_extras.compare_exchange_strong(extras, created, std::memory_order_acq_rel)) {
+            extras = created;
+        }
+        else {
+            delete created;
+        }
+    }
+    return extras;
+}
+
+AnyDictionary& SerializableObject::dynamic_fields() {
+    return _extras_or_create()->dynamic_fields;
 }
 
 TypeRegistry::_TypeRecord const* SerializableObject::_type_record() const {
-    std::lock_guard<std::mutex> lock(_mutex);
-    if (!_cached_type_record) {
-        _cached_type_record = TypeRegistry::instance()._lookup_type_record(typeid(*this));
-        if (!_cached_type_record) {
+    TypeRegistry::_TypeRecord const* type_record = _cached_type_record.load(std::memory_order_acquire);
+    if (!type_record) {
+        type_record = TypeRegistry::instance()._lookup_type_record(typeid(*this));
+        if (!type_record) {
             fatal_error(string_printf("Code for C++ type %s has not been registered via "
                                       "TypeRegistry::register_type<T>()",
                                       demangled_type_name(typeid(*this)).c_str()));
         }
+        _cached_type_record.store(type_record, std::memory_order_release);
     }
 
-    return _cached_type_record;
+    return type_record;
 }
 
 bool SerializableObject::_is_deletable() {
-    std::lock_guard<std::mutex> lock(_mutex);
     return _managed_ref_count == 0;
 }
 
@@ -42,23 +79,59 @@ bool SerializableObject::possibly_delete() {
 bool SerializableObject::read_from(Reader& reader) {
     /*
      * Want to move everything from reader._dict into
-     * _dynamic_fields, overwriting as we go.
+     * the dynamic fields, overwriting as we go.  (Only objects that have
+     * fields left over pay for keeping them.)
      */
+    if (reader._dict.empty()) {
+        return true;
+    }
+
+    AnyDictionary& dynamic_fields = this->dynamic_fields();
     for (auto& e: reader._dict) {
-        auto it = _dynamic_fields.find(e.first);
-        if (it != _dynamic_fields.end()) {
+        if (!reader._decode_unparsed(&e.second)) {
+            return false;
+        }
+
+        auto it = dynamic_fields.find(e.first);
+        if (it != dynamic_fields.end()) {
             it->second.swap(e.second);
         }
         else {
-            _dynamic_fields.emplace(e.first, std::move(e.second));
+            dynamic_fields.emplace(e.first, std::move(e.second));
         }
     }
     return true;
 }
 
+void SerializableObject::_set_undecodable(ErrorStatus const& error_status) {
+    _Extras* extras = _extras_or_create();
+    std::lock_guard<std::mutex> lock(extras->mutex);
+    if (!extras->undecodable) {
+        extras->undecodable = error_status;
+    }
+}
+
+bool SerializableObject::_undecodable(ErrorStatus* error_status) const {
+    _Extras* extras = _extras.load(std::memory_order_acquire);
+    if (!extras) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(extras->mutex);
+    *error_status = extras->undecodable;
+    return bool(*error_status);
+}
+
 void SerializableObject::write_to(Writer& writer) const {
-    for (auto e: _dynamic_fields) {
-        writer.write(e.first, e.second);
+    ErrorStatus error_status;
+    if (_undecodable(&error_status)) {
+        writer.error(error_status);
+    }
+
+    if (_Extras* extras = _extras.load(std::memory_order_acquire)) {
+        for (auto e: extras->dynamic_fields) {
+            writer.write(e.first, e.second);
+        }
     }
 }
 
@@ -70,8 +143,22 @@ std::string SerializableObject::to_json_string(ErrorStatus* error_status, int in
     return serialize_json_to_string(any(Retainer<>(this)), error_status, indent);
 }
 
-bool SerializableObject::to_json_file(std::string const& file_name, ErrorStatus* error_status, int indent) const {
-    return serialize_json_to_file(any(Retainer<>(this)), file_name, error_status, indent);
+bool SerializableObject::to_json_file(std::string const& file_name, ErrorStatus* error_status, int indent,
+                                      int max_threads) const {
+    return serialize_json_to_file(any(Retainer<>(this)), file_name, error_status, indent, max_threads);
+}
+
+static SerializableObject* _take_serializable_object(any& dest, ErrorStatus* error_status) {
+    if (dest.type() != typeid(SerializableObject::Retainer<>)) {
+        if (!(*error_status)) {
+            *error_status = ErrorStatus(ErrorStatus::TYPE_MISMATCH,
+                                        string_printf("Expected a SerializableObject*, found object of type '%s' instead",
+                                                      demangled_type_name(dest.type()).c_str()));
+        }
+        return nullptr;
+    }
+
+    return any_cast<SerializableObject::Retainer<>&>(dest).take_value();
 }
 
 SerializableObject* SerializableObject::from_json_string(std::string const& input, ErrorStatus* error_status) {
@@ -81,36 +168,48 @@ SerializableObject* SerializableObject::from_json_string(std::string const& inpu
         return nullptr;
     }
 
-    if (dest.type() != typeid(Retainer<>)) {
-        if (!(*error_status)) {
-            *error_status = ErrorStatus(ErrorStatus::TYPE_MISMATCH,
-                                        string_printf("Expected a SerializableObject*, found object of type '%s' instead",
-                                                      demangled_type_name(dest.type()).c_str()));
-        }
+    return _take_serializable_object(dest, error_status);
+}
+
+
+SerializableObject* SerializableObject::from_json_file(std::string const& file_name, ErrorStatus* error_status,
+                                                      int max_threads, bool lazy) {
+    any dest;
+
+    if (!deserialize_json_from_file(file_name, &dest, error_status, max_threads, lazy)) {
         return nullptr;
     }
 
-    return any_cast<Retainer<>&>(dest).take_value();
+    return _take_serializable_object(dest, error_status);
 }
 
+std::string SerializableObject::to_binary_string(ErrorStatus* error_status, bool object_offsets) const {
+    return serialize_binary_to_string(any(Retainer<>(this)), error_status, object_offsets);
+}
+
+bool SerializableObject::to_binary_file(std::string const& file_name, ErrorStatus* error_status,
+                                        bool object_offsets) const {
+    return serialize_binary_to_file(any(Retainer<>(this)), file_name, error_status, object_offsets);
+}
 
-SerializableObject* SerializableObject::from_json_file(std::string const& file_name, ErrorStatus* error_status) {
+SerializableObject* SerializableObject::from_binary_string(std::string const& input, ErrorStatus* error_status) {
     any dest;
 
-    if (!deserialize_json_from_file(file_name, &dest, error_status)) {
+    if (!deserialize_binary_from_string(input, &dest, error_status)) {
         return nullptr;
     }
 
-    if (dest.type() != typeid(Retainer<>)) {
-        if (!(*error_status)) {
-            *error_status = ErrorStatus(ErrorStatus::TYPE_MISMATCH,
-                                        string_printf("Expected a SerializableObject*, found object of type '%s' instead",
-                                                      demangled_type_name(dest.type()).c_str()));
-        }
+    return _take_serializable_object(dest, error_status);
+}
+
+SerializableObject* SerializableObject::from_binary_file(std::string const& file_name, ErrorStatus* error_status) {
+    any dest;
+
+    if (!deserialize_binary_from_file(file_name, &dest, error_status)) {
         return nullptr;
     }
 
-    return any_cast<Retainer<>&>(dest).take_value();
+    return _take_serializable_object(dest, error_status);
 }
 
 std::string const& SerializableObject::_schema_name_for_reference() const {
@@ -118,54 +217,58 @@ std::string const& SerializableObject::_schema_name_for_reference() const {
 }
 
 void SerializableObject::_managed_retain() {
-    {
-        std::lock_guard<std::mutex> lock(_mutex);
-        if (_managed_ref_count++ != 1 || !_external_keepalive_monitor)
-            return;
-    }
+    if (_managed_ref_count++ != 1)
+        return;
 
-    // We just changed from unique (old ref count was 1) to non-unique
-    // and we know we have a monitor.
-    _external_keepalive_monitor();
+    // We just changed from unique (old ref count was 1) to non-unique.
+    _notify_keepalive_monitor();
 }
 
 void SerializableObject::_managed_release() {
-    _mutex.lock();
-
-    if (--_managed_ref_count == 0) {
-        _mutex.unlock();
+    int count = --_managed_ref_count;
+    if (count == 0) {
         delete this;
         return;
     }
-        
-    if (_managed_ref_count != 1 || !_external_keepalive_monitor) {
-        _mutex.unlock();
+
+    if (count == 1) {
+        // We just changed back to unique (new ref count is 1).
+        _notify_keepalive_monitor();
+    }
+}
+
+void SerializableObject::_notify_keepalive_monitor() {
+    _Extras* extras = _extras.load(std::memory_order_acquire);
+    if (!extras) {
         return;
     }
 
-    // We just changed back to unique (new ref count is 1)
-    // and we know we have a monitor.
+    {
+        std::lock_guard<std::mutex> lock(extras->mutex);
+        if (!extras->external_keepalive_monitor)
+            return;
+    }
 
-    _mutex.unlock();
-    _external_keepalive_monitor();
+    // The monitor is never replaced once installed.
+    extras->external_keepalive_monitor();
 }
 
 void SerializableObject::install_external_keepalive_monitor(std::function<void ()> monitor,
                                                             bool apply_now) {
+    _Extras* extras = _extras_or_create();
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        if (!_external_keepalive_monitor) {
-            _external_keepalive_monitor = monitor;
+        std::lock_guard<std::mutex> lock(extras->mutex);
+        if (!extras->external_keepalive_monitor) {
+            extras->external_keepalive_monitor = monitor;
         }
     }
     
     if (apply_now) {
-        _external_keepalive_monitor();
+        extras->external_keepalive_monitor();
     }
 }
 
 int SerializableObject::current_ref_count() const {
-    std::lock_guard<std::mutex> lock(_mutex);
     return _managed_ref_count;
 }
 
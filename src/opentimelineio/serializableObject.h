@@ -2,6 +2,7 @@
 
 #include "opentimelineio/version.h"
 #include "opentimelineio/errorStatus.h"
+#include "opentimelineio/objectArena.h"
 #include "opentimelineio/anyVector.h"
 #include "opentimelineio/anyDictionary.h"
 #include "opentimelineio/optional.h"
@@ -11,8 +12,12 @@
 #include "opentime/timeRange.h"
 #include "opentime/timeTransform.h"
 
+#include <atomic>
+#include <functional>
 #include <list>
+#include <memory>
 #include <type_traits>
+#include <unordered_map>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
@@ -25,6 +30,18 @@ public:
 
     SerializableObject();
 
+    // Objects may be allocated in blocks; see ObjectArena.
+    static void* operator new(size_t size) {
+        return ObjectArena::allocate(size);
+    }
+
+    static void operator delete(void* pointer) {
+        ObjectArena::deallocate(pointer);
+    }
+
+    // The clone constructor, used by clone() (see Cloner).
+    SerializableObject(SerializableObject const& source, Cloner& cloner);
+
     /*
      * You cannot directly delete a SerializableObject* (or, hopefully, anything
      * derived from it, as all derivations are required to protect the destructor).
@@ -36,12 +53,22 @@ public:
      */
     bool possibly_delete();
 
-    bool to_json_file(std::string const& file_name, ErrorStatus* error_status, int indent = 4) const;
+    bool to_json_file(std::string const& file_name, ErrorStatus* error_status, int indent = 4,
+                      int max_threads = 1) const;
     std::string to_json_string(ErrorStatus* error_status, int indent = 4) const;
 
-    static SerializableObject* from_json_file(std::string const& file_name, ErrorStatus* error_status);
+    static SerializableObject* from_json_file(std::string const& file_name, ErrorStatus* error_status,
+                                              int max_threads = 1, bool lazy = false);
     static SerializableObject* from_json_string(std::string const& input, ErrorStatus* error_status);
 
+    // The same, in the compact binary form (see serialize_binary_to_string()).
+    bool to_binary_file(std::string const& file_name, ErrorStatus* error_status,
+                        bool object_offsets = false) const;
+    std::string to_binary_string(ErrorStatus* error_status, bool object_offsets = false) const;
+
+    static SerializableObject* from_binary_file(std::string const& file_name, ErrorStatus* error_status);
+    static SerializableObject* from_binary_string(std::string const& input, ErrorStatus* error_status);
+
     bool is_equivalent_to(SerializableObject const& other) const;
 
     // Makes a (deep) clone of this instance.
@@ -49,16 +76,26 @@ public:
     // Descendent SerializableObjects are cloned as well.
     // If the operation fails, nullptr is returned and error_status
     // is set appropriately.
-    SerializableObject* clone(ErrorStatus* error_status) const;
+    //
+    // Objects whose types were registered with a clone constructor are
+    // copied directly; the rest are cloned by way of their serialized form.
+    //
+    // If share_metadata is set, metadata holding only plain values (no
+    // objects) is copied once and then shared by the copy and all clones
+    // made from it in turn, each taking its own copy the first time it asks
+    // for non-const access to it.  This saves memory when keeping many
+    // versions of a timeline, each cloned from the last, that each change
+    // only a few of its objects.
+    SerializableObject* clone(ErrorStatus* error_status, bool share_metadata = false) const;
 
     // Allow external system (e.g. Python, Swifft) to add serializable fields
     // on the fly.  C++ implementations should have no need for this functionality.
-    AnyDictionary& dynamic_fields() {
-        return _dynamic_fields;
-    }
+    AnyDictionary& dynamic_fields();
 
     template <typename T = SerializableObject> struct Retainer;
 
+    struct UnparsedJSON;
+
     class Reader {
     public:
         void debug_dict() {
@@ -99,8 +136,11 @@ public:
 
         template <typename T>
         bool read(std::string const& key, Retainer<T>* dest) {
+            // the value read may be all that is keeping the object alive,
+            // so hold onto it until dest has taken over
+            any a;
             SerializableObject* so;
-            if (!read(key, &so)) {
+            if (!read(key, &a) || !_from_any(a, &so)) {
                 return false;
             }
 
@@ -130,6 +170,11 @@ public:
             return has_key(key) ? read(key, dest) : true;
         }
 
+        // If a lazy load left the value under key undecoded, moves it into
+        // dest (for the caller to decode when it's needed) and returns true.
+        // Otherwise returns false, leaving the value to be read as usual.
+        bool read_unparsed(std::string const& key, UnparsedJSON* dest);
+
         void error(ErrorStatus const& error_status) {
             _error(error_status);
         }
@@ -143,7 +188,7 @@ public:
             std::map<SerializableObject*, int> line_number_for_object;
 
             void finalize(error_function_t error_function) {
-                for (auto e: data_for_object) {
+                for (auto& e: data_for_object) {
                     int line_number = line_number_for_object[e.first];
                     Reader::_fix_reference_ids(e.second, error_function, *this, line_number);
                     Reader r(e.second, error_function, e.first, line_number);
@@ -152,7 +197,10 @@ public:
             }
         };
             
-        any _decode(_Resolver& resolver);
+        // Turns our dictionary into the value it encodes.  A schema object
+        // is read in right away if read_now is set, and otherwise left for
+        // the resolver to read once every object has been created.
+        any _decode(_Resolver& resolver, bool read_now = false);
 
         template <typename T>
         bool _from_any(any const& source, std::vector<T>* dest) {
@@ -290,6 +338,7 @@ public:
         bool _fetch(std::string const& key, int64_t* dest);
         bool _fetch(std::string const& key, double* dest);
         bool _fetch(std::string const& key, SerializableObject** dest);
+        bool _decode_unparsed(any* value);
         bool _type_check(std::type_info const& wanted, std::type_info const& found);
         bool _type_check_so(std::type_info const& wanted, std::type_info const& found,
                             std::type_info const& so_type);
@@ -316,7 +365,14 @@ public:
     
     class Writer {
     public:
-        static bool write_root(any const& value, class Encoder& encoder, ErrorStatus* error_status);
+        // With max_threads above 1, and an encoder that supports it, the
+        // elements of each outermost array of at least max_threads objects
+        // are written on up to that many threads.
+        static bool write_root(any const& value, class Encoder& encoder, ErrorStatus* error_status,
+                               int max_threads = 1);
+
+        // Fails the write with error_status.
+        void error(ErrorStatus const& error_status);
 
         void write(std::string const& key, bool value);
         void write(std::string const& key, int64_t value);
@@ -409,13 +465,14 @@ public:
         
         Writer(class Encoder& encoder)
             : _encoder(encoder) {
-            _build_dispatch_tables();
         }
 
         Writer(Writer const&) = delete;
         Writer operator=(Writer const&) = delete;
 
-        void _build_dispatch_tables();
+        int _value_type(std::type_info const& type);
+        void _write_root(any const& value);
+        void _write_elements_in_parallel(AnyVector const& elements);
         void _write(std::string const& key, any const& value);
         void _encoder_write_key(std::string const& key);
 
@@ -424,12 +481,26 @@ public:
         bool _any_equals(any const& lhs, any const& rhs);
 
         std::string _no_key;
-        std::map<std::type_info const*, std::function<void (any const&)>> _write_dispatch_table;
-        std::map<std::type_info const*, std::function<bool (any const&, any const&)>> _equality_dispatch_table;
 
-        std::map<std::string, std::function<void (any const&)>> _write_dispatch_table_by_name;
-        std::map<SerializableObject const*, std::string> _id_for_object;
+        // Value types only known by name here, because of type aliasing
+        // across compilation units, paired with what _value_type() found.
+        std::vector<std::pair<std::type_info const*, int>> _aliased_value_types;
+
+        // The objects being written, innermost last, to catch cycles.
+        std::vector<SerializableObject const*> _objects_in_progress;
+
+        /*
+         * With instancing support, only objects reached more than once get
+         * an OTIO_REF_ID.  A first pass, with _counting_references set,
+         * counts how often each object is reached; the objects it reached
+         * more than once are then given ids per schema as they are written.
+         * (0 until they are.)
+         */
+        std::unordered_map<SerializableObject const*, int> _shared_object_ids;
         std::map<std::string, int> _next_id_for_type;
+        bool _counting_references = false;
+
+        int _max_threads = 1;
 
         class Encoder& _encoder;
         friend class SerializableObject;
@@ -501,6 +572,12 @@ protected:
     virtual ~SerializableObject();
     virtual bool _is_deletable();
 
+    // For a value that a lazy load left undecoded (see UnparsedJSON) and that
+    // turned out not to decode, or not into what it had to be.  Rather than
+    // leave the value out, writing or cloning this object then fails with
+    // error_status (the first one given, if there were several).
+    void _set_undecodable(ErrorStatus const& error_status);
+
 private:
     SerializableObject(SerializableObject const&) = delete;
     SerializableObject& operator=(SerializableObject const&) = delete;
@@ -519,6 +596,17 @@ public:
         }
     };
 
+    // A value that a lazy load left as the JSON text it was read from, to be
+    // decoded when it is first needed.  source keeps that text alive.
+    struct UnparsedJSON {
+        std::shared_ptr<void const> source;
+        char const* data = nullptr;
+        size_t size = 0;
+        int line_number = 1;
+
+        bool decode(any* destination, ErrorStatus* error_status) const;
+    };
+
     void install_external_keepalive_monitor(std::function<void ()> monitor, bool apply_now);
 
     int current_ref_count() const;
@@ -534,14 +622,98 @@ private:
     
     TypeRegistry::_TypeRecord const* _type_record() const;
 
-    mutable TypeRegistry::_TypeRecord const* _cached_type_record;
-    int _managed_ref_count;
-    std::function<void ()> _external_keepalive_monitor;
+    SerializableObject* _clone_by_encoding(ErrorStatus* error_status) const;
+
+    // What was given to _set_undecodable(), if anything.
+    bool _undecodable(ErrorStatus* error_status) const;
 
-    mutable std::mutex _mutex;
+    /*
+     * Most objects never have dynamic fields or a keepalive monitor, so these
+     * (and the mutex guarding the monitor) only get allocated once something
+     * asks for them.
+     */
+    struct _Extras;
+
+    _Extras* _extras_or_create();
+    void _notify_keepalive_monitor();
 
-    AnyDictionary _dynamic_fields;
+    mutable std::atomic<TypeRegistry::_TypeRecord const*> _cached_type_record;
+    std::atomic<_Extras*> _extras;
+    std::atomic<int> _managed_ref_count;
     friend class TypeRegistry;
+    friend class Cloner;
+};
+
+/*
+ * Copies objects, and the values they hold, for SerializableObject::clone().
+ *
+ * A class takes part by giving itself a clone constructor,
+ *
+ *     MyClass(MyClass const& source, Cloner& cloner);
+ *
+ * which passes source and cloner to its parent class's clone constructor and
+ * then copies its own fields, running any objects, dictionaries or vectors of
+ * objects through cloner.clone().  TypeRegistry::register_type<MyClass>()
+ * finds the constructor.  As with cloning through the serialized form, an
+ * object reached twice is copied twice, and reaching an object from inside
+ * itself fails the clone.
+ */
+class Cloner {
+public:
+    explicit Cloner(bool share_metadata = false)
+        : _share_metadata(share_metadata) {
+    }
+
+    // Whether copies may share plain metadata with their sources; see
+    // SerializableObject::clone().
+    bool share_metadata() const {
+        return _share_metadata;
+    }
+
+    // True if value holds nothing that clone() would do more than copy
+    // (such as an object), so that a copy of it is as good as a clone.
+    static bool is_plain(AnyDictionary const& value);
+    static bool is_plain(any const& value);
+
+    // The copy, not yet retained, or nullptr if source is null or the clone
+    // has failed.
+    SerializableObject* clone(SerializableObject const* source);
+
+    template <typename T>
+    SerializableObject::Retainer<T> clone(SerializableObject::Retainer<T> const& source) {
+        SerializableObject::Retainer<> copy(clone(static_cast<SerializableObject const*>(source.value)));
+        T* value = dynamic_cast<T*>(copy.value);
+        if (copy && !value) {
+            _failed = true;
+        }
+        return SerializableObject::Retainer<T>(value);
+    }
+
+    template <typename T>
+    std::vector<SerializableObject::Retainer<T>> clone(std::vector<SerializableObject::Retainer<T>> const& source) {
+        std::vector<SerializableObject::Retainer<T>> copy;
+        copy.reserve(source.size());
+        for (auto const& e: source) {
+            copy.push_back(clone(e));
+        }
+        return copy;
+    }
+
+    AnyDictionary clone(AnyDictionary const& source);
+    AnyVector clone(AnyVector const& source);
+    any clone(any const& source);
+
+    // True if a value couldn't be copied directly.  The clone is then redone
+    // by way of the serialized form, which also gives the proper error for
+    // values that can't be cloned at all.
+    bool failed() const {
+        return _failed;
+    }
+
+private:
+    std::vector<SerializableObject const*> _objects_in_progress;
+    bool _share_metadata;
+    bool _failed = false;
 };
     
 } }
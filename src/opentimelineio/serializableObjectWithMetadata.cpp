@@ -1,5 +1,8 @@
 #include "opentimelineio/serializableObjectWithMetadata.h"
 
+#include <algorithm>
+#include <mutex>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
 SerializableObjectWithMetadata::SerializableObjectWithMetadata(std::string const& name,
@@ -9,18 +12,149 @@ SerializableObjectWithMetadata::SerializableObjectWithMetadata(std::string const
 {
 }
 
+SerializableObjectWithMetadata::SerializableObjectWithMetadata(SerializableObjectWithMetadata const& source,
+                                                               Cloner& cloner)
+    : Parent(source, cloner),
+      _name(source._name) {
+    if (cloner.share_metadata()) {
+        _shared_metadata = source._metadata_to_share();
+    }
+    if (!_shared_metadata) {
+        _metadata = cloner.clone(source.metadata());
+    }
+}
+
 SerializableObjectWithMetadata::~SerializableObjectWithMetadata() {
+    delete _unparsed_metadata.exchange(nullptr);
 }
 
 bool SerializableObjectWithMetadata::read_from(Reader& reader) {
+    UnparsedJSON unparsed;
+    if (reader.read_unparsed("metadata", &unparsed)) {
+        if (!(reader.read_if_present("name", &_name) &&
+              SerializableObject::read_from(reader))) {
+            return false;
+        }
+        _unparsed_metadata.store(new UnparsedJSON(std::move(unparsed)), std::memory_order_release);
+        return true;
+    }
+
     return reader.read_if_present("metadata", &_metadata) &&
         reader.read_if_present("name", &_name) &&
         SerializableObject::read_from(reader);
 }
 
+// As with Composition's children, errors an eager load would have reported
+// can't be by now, so metadata that doesn't decode to a dictionary is kept
+// back as an error for writing or cloning us to report.
+void SerializableObjectWithMetadata::_decode_unparsed_metadata() {
+    // Threads wanting it at the same time all wait for the first to decode
+    // it.
+    std::call_once(_metadata_decoded, [this] {
+        UnparsedJSON* unparsed = _unparsed_metadata.load(std::memory_order_relaxed);
+        if (!unparsed) {
+            return;
+        }
+
+        any decoded;
+        ErrorStatus error_status;
+        if (!unparsed->decode(&decoded, &error_status)) {
+            _set_undecodable(error_status);
+        }
+        else if (decoded.type() != typeid(AnyDictionary)) {
+            _set_undecodable(ErrorStatus(ErrorStatus::TYPE_MISMATCH,
+                                         string_printf("metadata read from line %d isn't a dictionary",
+                                                       unparsed->line_number),
+                                         this));
+        }
+        else {
+            _metadata = std::move(any_cast<AnyDictionary&>(decoded));
+        }
+
+        _unparsed_metadata.store(nullptr, std::memory_order_release);
+        delete unparsed;
+    });
+}
+
+// Whether a dictionary or list nested in value has been handed out to be
+// written through (as Python's handles on them are).
+static bool _has_nested_handles(any const& value) {
+    if (value.type() == typeid(AnyDictionary)) {
+        auto& d = any_cast<AnyDictionary const&>(value);
+        return d.mutation_stamp() ||
+            std::any_of(d.begin(), d.end(), [](AnyDictionary::value_type const& e) {
+                return _has_nested_handles(e.second);
+            });
+    }
+    if (value.type() == typeid(AnyVector)) {
+        auto& v = any_cast<AnyVector const&>(value);
+        return v.mutation_stamp() || std::any_of(v.begin(), v.end(), _has_nested_handles);
+    }
+    return false;
+}
+
+/*
+ * Empty metadata isn't worth sharing, and metadata holding objects can't be:
+ * the objects themselves would be shared.  Metadata we share already goes on
+ * being shared; otherwise, on the first clone, we move _metadata into a copy
+ * that we and all our clones share.  If something nested in it has been
+ * handed out to be written through, though, those writes have to go on
+ * reaching our own _metadata, so each clone gets a copy of it instead.
+ */
+std::shared_ptr<AnyDictionary const> SerializableObjectWithMetadata::_metadata_to_share() const {
+    _decode_metadata();
+    if (_shared_metadata) {
+        return _shared_metadata;
+    }
+
+    if (_metadata.empty() || !Cloner::is_plain(_metadata)) {
+        return nullptr;
+    }
+    if (std::any_of(_metadata.begin(), _metadata.end(), [](AnyDictionary::value_type const& e) {
+            return _has_nested_handles(e.second);
+        })) {
+        return std::make_shared<AnyDictionary const>(_metadata);
+    }
+
+    auto self = const_cast<SerializableObjectWithMetadata*>(this);
+    self->_shared_metadata = std::make_shared<AnyDictionary const>(std::move(self->_metadata));
+    self->_update_metadata_mutation_stamp();
+    return _shared_metadata;
+}
+
+void SerializableObjectWithMetadata::_unshare_metadata() {
+    _metadata = *_shared_metadata;
+    _shared_metadata.reset();
+    _update_metadata_mutation_stamp();
+}
+
+// Keeps a handle on _metadata reading what we share, while we share it.
+void SerializableObjectWithMetadata::_update_metadata_mutation_stamp() {
+    if (auto stamp = _metadata.mutation_stamp()) {
+        stamp->shared = _shared_metadata.get();
+        if (_shared_metadata && !stamp->unshare) {
+            // unshare is left set once it is, as it may be what is calling us
+            stamp->unshare = [this]() {
+                if (_shared_metadata) {
+                    _unshare_metadata();
+                }
+            };
+        }
+    }
+}
+
+AnyDictionary::MutationStamp* SerializableObjectWithMetadata::metadata_mutation_stamp() {
+    _decode_metadata();
+    auto stamp = _metadata.get_or_create_mutation_stamp();
+    _update_metadata_mutation_stamp();
+    return stamp;
+}
+
 void SerializableObjectWithMetadata::write_to(Writer& writer) const {
+    // First, so that SerializableObject::write_to() reports it if it fails.
+    _decode_metadata();
     SerializableObject::write_to(writer);
-    writer.write("metadata", _metadata);
+    writer.write("metadata", metadata());
     writer.write("name", _name);
 }
 
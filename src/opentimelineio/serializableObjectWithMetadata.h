@@ -3,6 +3,10 @@
 #include "opentimelineio/version.h"
 #include "opentimelineio/serializableObject.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
 class SerializableObjectWithMetadata : public SerializableObject {
@@ -17,6 +21,8 @@ public:
     SerializableObjectWithMetadata(std::string const& name = std::string(),
                                    AnyDictionary const& metadata = AnyDictionary());
 
+    SerializableObjectWithMetadata(SerializableObjectWithMetadata const& source, Cloner& cloner);
+
     std::string const& name() const {
         return _name;
     }
@@ -25,22 +31,57 @@ public:
         _name = name;
     }
 
+    // If clone() left the metadata shared, this takes a copy of it first, and
+    // references from the const form may then no longer be valid.  Cloning
+    // with share_metadata may in turn move the metadata into a copy shared
+    // with the clones, leaving references from either form empty.
     AnyDictionary& metadata() {
+        _decode_metadata();
+        if (_shared_metadata) {
+            _unshare_metadata();
+        }
         return _metadata;
     }
 
     AnyDictionary const& metadata() const {
-        return _metadata;
+        _decode_metadata();
+        return _shared_metadata ? *_shared_metadata : _metadata;
     }
 
+    // For bridges to other languages (e.g. Python): a handle on the metadata
+    // (see AnyDictionary::MutationStamp) that reads it without taking a copy
+    // of it while it is shared, taking one only to write it.
+    AnyDictionary::MutationStamp* metadata_mutation_stamp();
+
 protected:
     ~SerializableObjectWithMetadata();
     virtual bool read_from(Reader&);
     virtual void write_to(Writer&) const;
 
 private:
+    // In case a lazy load left the metadata undecoded.
+    void _decode_metadata() const {
+        if (_unparsed_metadata.load(std::memory_order_acquire)) {
+            const_cast<SerializableObjectWithMetadata*>(this)->_decode_unparsed_metadata();
+        }
+    }
+
+    void _decode_unparsed_metadata();
+
+    std::shared_ptr<AnyDictionary const> _metadata_to_share() const;
+    void _unshare_metadata();
+    void _update_metadata_mutation_stamp();
+
     std::string _name;
     AnyDictionary _metadata;
+    std::atomic<UnparsedJSON*> _unparsed_metadata { nullptr };
+    std::once_flag _metadata_decoded;
+
+    // Metadata shared with the object we were cloned from, or with the
+    // clones made from us, and with their other clones (see
+    // SerializableObject::clone()); _metadata is left empty while this is
+    // set.
+    std::shared_ptr<AnyDictionary const> _shared_metadata;
 };
 
 } }
@@ -1,13 +1,19 @@
 #include "opentimelineio/serializableObject.h"
 #include "opentimelineio/unknownSchema.h"
 #include "opentimelineio/stringUtils.h"
+#include "opentimelineio/binaryFormat.h"
+#include "opentimelineio/compression.h"
 
 #define RAPIDJSON_NAMESPACE OTIO_rapidjson
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <rapidjson/prettywriter.h>
-#include <rapidjson/ostreamwrapper.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <fstream>
+#include <functional>
+#include <thread>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
@@ -55,6 +61,19 @@ public:
     virtual void write_value(class TimeTransform const& value) = 0;
     virtual void write_value(struct SerializableObject::ReferenceId) = 0;
 
+    /*
+     * To write the elements of an array on several threads, each element is
+     * written with an encoder of its own, from element_encoder(), which
+     * write_element() then adds to this encoder's array, in order.  Encoders
+     * that can't do this return nullptr.
+     */
+    virtual std::unique_ptr<Encoder> element_encoder() {
+        return nullptr;
+    }
+
+    virtual void write_element(Encoder&) {
+    }
+
 protected:
     void _error(ErrorStatus const& error_status) {
         _error_status = error_status;
@@ -257,11 +276,56 @@ private:
 };
 
 
+/*
+ * The same kind of rapidjson writer as RapidJSONWriterType, writing into a
+ * StringBuffer instead.
+ */
+template <typename RapidJSONWriterType>
+struct _JSONBufferWriter;
+
+template <typename OutputStream, typename SourceEncoding, typename TargetEncoding,
+          typename Allocator, unsigned flags>
+struct _JSONBufferWriter<OTIO_rapidjson::Writer<OutputStream, SourceEncoding, TargetEncoding,
+                                                Allocator, flags>> {
+    typedef OTIO_rapidjson::Writer<OTIO_rapidjson::StringBuffer, SourceEncoding, TargetEncoding,
+                                   Allocator, flags> type;
+};
+
+template <typename OutputStream, typename SourceEncoding, typename TargetEncoding,
+          typename Allocator, unsigned flags>
+struct _JSONBufferWriter<OTIO_rapidjson::PrettyWriter<OutputStream, SourceEncoding, TargetEncoding,
+                                                      Allocator, flags>> {
+    typedef OTIO_rapidjson::PrettyWriter<OTIO_rapidjson::StringBuffer, SourceEncoding, TargetEncoding,
+                                         Allocator, flags> type;
+};
+
+template <typename OutputStream, typename SourceEncoding, typename TargetEncoding,
+          typename Allocator, unsigned flags>
+static void _set_json_indent(OTIO_rapidjson::Writer<OutputStream, SourceEncoding, TargetEncoding,
+                                                    Allocator, flags>&, int) {
+}
+
+template <typename OutputStream, typename SourceEncoding, typename TargetEncoding,
+          typename Allocator, unsigned flags>
+static void _set_json_indent(OTIO_rapidjson::PrettyWriter<OutputStream, SourceEncoding, TargetEncoding,
+                                                          Allocator, flags>& writer, int indent) {
+    writer.SetIndent(' ', indent);
+}
+
+template <typename RapidJSONWriterType>
+class JSONElementEncoder;
+
+/*
+ * With indent at zero or more, RapidJSONWriterType must be a PrettyWriter
+ * using that indent; otherwise it must not be.
+ */
 template <typename RapidJSONWriterType>
 class JSONEncoder : public Encoder {
 public:
-    JSONEncoder(RapidJSONWriterType& writer)
-        : _writer(writer) {
+    JSONEncoder(RapidJSONWriterType& writer, int indent = -1)
+        : _writer(writer),
+          _indent(indent),
+          _depth(0) {
     }
     
     virtual ~JSONEncoder() {
@@ -359,22 +423,263 @@ public:
 
     void start_array(size_t) {
         _writer.StartArray();
+        _depth++;
     }
     
     void start_object() {
         _writer.StartObject();
+        _depth++;
     }
 
     void end_array() {
         _writer.EndArray();
+        _depth--;
     }
 
     void end_object() {
         _writer.EndObject();
+        _depth--;
+    }
+
+    std::unique_ptr<Encoder> element_encoder() {
+        return std::unique_ptr<Encoder>(new _ElementEncoder(_indent));
+    }
+
+    /*
+     * The element was written as if it were the whole document, so each of
+     * its lines after the first is indented as much again as the array's
+     * elements are here.
+     */
+    void write_element(Encoder& element_encoder) {
+        _ElementEncoder const& e = static_cast<_ElementEncoder&>(element_encoder);
+        char const* element = e.json();
+        size_t size = e.json_size();
+        if (_indent <= 0) {
+            _writer.RawValue(element, size, OTIO_rapidjson::kObjectType);
+            return;
+        }
+
+        std::string indented;
+        std::string const margin(size_t(_depth * _indent), ' ');
+        indented.reserve(size + size / 8);
+        for (size_t i = 0; i < size; i++) {
+            indented += element[i];
+            if (element[i] == '\n') {
+                indented += margin;
+            }
+        }
+        _writer.RawValue(indented.c_str(), indented.size(), OTIO_rapidjson::kObjectType);
     }
 
 private:
+    typedef JSONElementEncoder<typename _JSONBufferWriter<RapidJSONWriterType>::type> _ElementEncoder;
+
     RapidJSONWriterType& _writer;
+    int _indent;
+    int _depth;
+};
+
+template <typename RapidJSONWriterType>
+struct _JSONStringOutput {
+    _JSONStringOutput(int indent)
+        : writer(buffer) {
+        _set_json_indent(writer, indent);
+    }
+
+    OTIO_rapidjson::StringBuffer buffer;
+    RapidJSONWriterType writer;
+};
+
+/*
+ * Writes a single array element, for a JSONEncoder to add to its array.
+ */
+template <typename RapidJSONWriterType>
+class JSONElementEncoder : private _JSONStringOutput<RapidJSONWriterType>,
+                           public JSONEncoder<RapidJSONWriterType> {
+public:
+    JSONElementEncoder(int indent)
+        : _JSONStringOutput<RapidJSONWriterType>(indent),
+          JSONEncoder<RapidJSONWriterType>(this->writer, indent) {
+    }
+
+    char const* json() const {
+        return this->buffer.GetString();
+    }
+
+    size_t json_size() const {
+        return this->buffer.GetSize();
+    }
+};
+
+/*
+ * Encodes into the binary form described in binaryFormat.h.  The string
+ * table is only known once everything has been written, so it goes after
+ * the root value.
+ */
+class BinaryEncoder : public Encoder {
+public:
+    BinaryEncoder(bool object_offsets)
+        : _object_offsets(object_offsets) {
+        _out.append(binary_format::magic, binary_format::magic_size);
+        _out += char(binary_format::version);
+        _out += char(object_offsets ? binary_format::has_object_offsets : 0);
+    }
+
+    virtual ~BinaryEncoder() {
+    }
+
+    // Appends the trailer, after which nothing more can be written.
+    std::string& finish() {
+        size_t string_table_offset = _out.size();
+        binary_format::append_varint(_out, _strings.size());
+        for (auto s: _strings) {
+            binary_format::append_varint(_out, s->size());
+            _out.append(*s);
+        }
+
+        if (_object_offsets) {
+            binary_format::append_varint(_out, _object_offset_list.size());
+            size_t previous = 0;
+            for (size_t offset: _object_offset_list) {
+                binary_format::append_varint(_out, offset - previous);
+                previous = offset;
+            }
+        }
+
+        binary_format::append_fixed64(_out, string_table_offset);
+        return _out;
+    }
+
+    void write_key(std::string const& key) {
+        if (key == "OTIO_SCHEMA" && _object_start != std::string::npos) {
+            _object_offset_list.push_back(_object_start);
+        }
+        _object_start = std::string::npos;
+        _schema_value_next = (key == "OTIO_SCHEMA");
+
+        binary_format::append_varint(_out, _string_index(key) + 1);
+    }
+
+    void write_null_value() {
+        _tag(binary_format::null);
+    }
+
+    void write_value(bool value) {
+        _tag(value ? binary_format::true_value : binary_format::false_value);
+    }
+
+    void write_value(int value) {
+        write_value(int64_t(value));
+    }
+
+    void write_value(int64_t value) {
+        _tag(binary_format::integer);
+        binary_format::append_varint(_out, binary_format::zigzag_encode(value));
+    }
+
+    void write_value(uint64_t value) {
+        _tag(binary_format::unsigned_integer);
+        binary_format::append_varint(_out, value);
+    }
+
+    void write_value(double value) {
+        _tag(binary_format::number);
+        binary_format::append_double(_out, value);
+    }
+
+    void write_value(std::string const& value) {
+        if (_schema_value_next) {
+            _tag(binary_format::table_string);
+            binary_format::append_varint(_out, _string_index(value));
+            return;
+        }
+
+        _tag(binary_format::string);
+        binary_format::append_varint(_out, value.size());
+        _out.append(value);
+    }
+
+    void write_value(RationalTime const& value) {
+        _tag(binary_format::rational_time);
+        binary_format::append_double(_out, value.value());
+        binary_format::append_double(_out, value.rate());
+    }
+
+    void write_value(TimeRange const& value) {
+        _tag(binary_format::time_range);
+        binary_format::append_double(_out, value.start_time().value());
+        binary_format::append_double(_out, value.start_time().rate());
+        binary_format::append_double(_out, value.duration().value());
+        binary_format::append_double(_out, value.duration().rate());
+    }
+
+    void write_value(TimeTransform const& value) {
+        _tag(binary_format::time_transform);
+        binary_format::append_double(_out, value.offset().value());
+        binary_format::append_double(_out, value.offset().rate());
+        binary_format::append_double(_out, value.scale());
+        binary_format::append_double(_out, value.rate());
+    }
+
+    void write_value(SerializableObject::ReferenceId value) {
+        // the same as the JSON form, but not an object in its own right
+        _tag(binary_format::object);
+        _object_start = std::string::npos;
+        write_key("OTIO_SCHEMA");
+        write_value(std::string("SerializableObjectRef.1"));
+        write_key("id");
+        write_value(value.id);
+        _out += char(0);
+    }
+
+    void start_array(size_t n) {
+        _tag(binary_format::array);
+        binary_format::append_varint(_out, n);
+    }
+
+    void start_object() {
+        size_t start = _out.size();
+        _tag(binary_format::object);
+        _object_start = start;
+    }
+
+    void end_array() {
+    }
+
+    void end_object() {
+        _object_start = std::string::npos;
+        _out += char(0);
+    }
+
+private:
+    void _tag(binary_format::Tag tag) {
+        _out += char(tag);
+        _object_start = std::string::npos;
+        _schema_value_next = false;
+    }
+
+    size_t _string_index(std::string const& s) {
+        auto e = _string_indices.find(s);
+        if (e != _string_indices.end()) {
+            return e->second;
+        }
+
+        e = _string_indices.emplace(s, _strings.size()).first;
+        _strings.push_back(&e->first);
+        return e->second;
+    }
+
+    std::string _out;
+    std::map<std::string, size_t> _string_indices;
+    std::vector<std::string const*> _strings;
+
+    bool _object_offsets;
+    std::vector<size_t> _object_offset_list;
+
+    // Where the object just started begins, until its first key shows
+    // whether it has a schema.
+    size_t _object_start = std::string::npos;
+    bool _schema_value_next = false;
 };
 
 template <typename T>
@@ -394,60 +699,80 @@ bool _simple_any_comparison<char const*>(any const& lhs, any const& rhs) {
            !strcmp(any_cast<char const*>(lhs), any_cast<char const*>(rhs));
 }
 
-void SerializableObject::Writer::_build_dispatch_tables() {
-    /*
-     * These are basically atomic writes to the encoder:
-     */
-    auto& wt = _write_dispatch_table;
-    wt[&typeid(void)] = [this](any const&) { _encoder.write_null_value(); };
-    wt[&typeid(bool)] = [this](any const& value) { _encoder.write_value(any_cast<bool>(value)); };
-    wt[&typeid(int64_t)] = [this](any const& value) { _encoder.write_value(any_cast<int64_t>(value)); };
-    wt[&typeid(double)] = [this](any const& value) { _encoder.write_value(any_cast<double>(value)); };
-    wt[&typeid(std::string)] = [this](any const& value) { _encoder.write_value(any_cast<std::string const&>(value)); };
-    wt[&typeid(char const*)] = [this](any const& value) {
-        _encoder.write_value(std::string(any_cast<char const*>(value))); };
-    wt[&typeid(RationalTime)] = [this](any const& value) { _encoder.write_value(any_cast<RationalTime const&>(value)); };
-    wt[&typeid(TimeRange)] = [this](any const& value) { _encoder.write_value(any_cast<TimeRange const&>(value)); };
-    wt[&typeid(TimeTransform)] = [this](any const& value) { _encoder.write_value(any_cast<TimeTransform const&>(value)); };
-
-    /*
-     * These next recurse back through the Writer itself:
-     */
-    wt[&typeid(SerializableObject::Retainer<>)] = [this](any const& value) {
-        this->write(_no_key, any_cast<SerializableObject::Retainer<>>(value).value); };
+/*
+ * The value types that Writer knows how to write and compare; a value of
+ * any other type is an error.  _value_type() gives the index of a type in
+ * _writer_value_types(), and Writer switches on that.
+ */
+enum _WriterValueType {
+    _void_value,
+    _bool_value,
+    _int64_value,
+    _double_value,
+    _string_value,
+    _c_string_value,
+    _rational_time_value,
+    _time_range_value,
+    _time_transform_value,
+    _retainer_value,
+    _dictionary_value,
+    _vector_value,
+    _reference_id_value,
+    _writer_value_type_count,
+    _unknown_value = -1
+};
 
-    wt[&typeid(AnyDictionary)] = [this](any const& value) {
-        this->write(_no_key, any_cast<AnyDictionary const&>(value)); };
+static std::type_info const* const* _writer_value_types() {
+    static std::type_info const* const types[_writer_value_type_count] = {
+        &typeid(void),
+        &typeid(bool),
+        &typeid(int64_t),
+        &typeid(double),
+        &typeid(std::string),
+        &typeid(char const*),
+        &typeid(RationalTime),
+        &typeid(TimeRange),
+        &typeid(TimeTransform),
+        &typeid(SerializableObject::Retainer<>),
+        &typeid(AnyDictionary),
+        &typeid(AnyVector),
+        &typeid(SerializableObject::ReferenceId)
+    };
+    return types;
+}
 
-    wt[&typeid(AnyVector)] = [this](any const& value) {
-        this->write(_no_key, any_cast<AnyVector const&>(value)); };
+int SerializableObject::Writer::_value_type(std::type_info const& type) {
+    std::type_info const* const* types = _writer_value_types();
+    for (int i = 0; i < _writer_value_type_count; i++) {
+        if (types[i] == &type) {
+            return i;
+        }
+    }
 
     /*
-     * Install a backup table, using the actual type name as a key.
-     * This is to deal with type aliasing across compilation units.
+     * Using the address of a type_info suffers from aliasing across compilation units.
+     * If we fail on a lookup, we fallback on comparing type names, but that's slow.
+     *
+     * So when we fail, we remember the address of the type_info that failed to be found,
+     * so that we'll catch it the next time.  This ensures we fail exactly once per alias
+     * per type while using this writer.
      */
-    for (auto e: wt) {
-        _write_dispatch_table_by_name[e.first->name()] = e.second;
-    }
-
-    auto& et = _equality_dispatch_table;
-    et[&typeid(void)] = &_simple_any_comparison<void>;
-    et[&typeid(bool)] = &_simple_any_comparison<bool>;
-    et[&typeid(int64_t)] = &_simple_any_comparison<int64_t>;
-    et[&typeid(double)] = &_simple_any_comparison<double>;
-    et[&typeid(std::string)] = &_simple_any_comparison<std::string>;
-    et[&typeid(char const*)] = &_simple_any_comparison<char const*>;
-    et[&typeid(RationalTime)] = &_simple_any_comparison<RationalTime>;
-    et[&typeid(TimeRange)] = &_simple_any_comparison<TimeRange>;
-    et[&typeid(TimeTransform)] = &_simple_any_comparison<TimeTransform>;
-    et[&typeid(SerializableObject::ReferenceId)] = &_simple_any_comparison<SerializableObject::ReferenceId>;
+    for (auto const& e: _aliased_value_types) {
+        if (e.first == &type) {
+            return e.second;
+        }
+    }
 
-    /*
-     * These next recurse back through the Writer itself:
-     */
-    et[&typeid(AnyDictionary)] = [this](any const& lhs, any const& rhs) { return _any_dict_equals(lhs, rhs); };
-    et[&typeid(AnyVector)] = [this](any const& lhs, any const& rhs) { return _any_array_equals(lhs, rhs); };
+    int value_type = _unknown_value;
+    for (int i = 0; i < _writer_value_type_count; i++) {
+        if (!strcmp(types[i]->name(), type.name())) {
+            value_type = i;
+            break;
+        }
+    }
 
+    _aliased_value_types.emplace_back(&type, value_type);
+    return value_type;
 }
 
 bool SerializableObject::Writer::_any_dict_equals(any const& lhs, any const& rhs) {
@@ -460,7 +785,7 @@ bool SerializableObject::Writer::_any_dict_equals(any const& lhs, any const& rhs
 
     auto r_it = rd.begin();
 
-    for (auto l_it : ld) {
+    for (auto const& l_it : ld) {
         if (r_it == rd.end()) {
             return false;
         }
@@ -495,16 +820,101 @@ bool SerializableObject::Writer::_any_array_equals(any const& lhs, any const& rh
 }
 
 bool SerializableObject::Writer::_any_equals(any const& lhs, any const& rhs) {
-    auto e = _equality_dispatch_table.find(&lhs.type());
-    return (e != _equality_dispatch_table.end()) && e->second(lhs, rhs);
+    switch (_value_type(lhs.type())) {
+    case _void_value:
+        return _simple_any_comparison<void>(lhs, rhs);
+    case _bool_value:
+        return _simple_any_comparison<bool>(lhs, rhs);
+    case _int64_value:
+        return _simple_any_comparison<int64_t>(lhs, rhs);
+    case _double_value:
+        return _simple_any_comparison<double>(lhs, rhs);
+    case _string_value:
+        return _simple_any_comparison<std::string>(lhs, rhs);
+    case _c_string_value:
+        return _simple_any_comparison<char const*>(lhs, rhs);
+    case _rational_time_value:
+        return _simple_any_comparison<RationalTime>(lhs, rhs);
+    case _time_range_value:
+        return _simple_any_comparison<TimeRange>(lhs, rhs);
+    case _time_transform_value:
+        return _simple_any_comparison<TimeTransform>(lhs, rhs);
+    case _reference_id_value:
+        return _simple_any_comparison<SerializableObject::ReferenceId>(lhs, rhs);
+
+    /*
+     * These next recurse back through the Writer itself:
+     */
+    case _dictionary_value:
+        return _any_dict_equals(lhs, rhs);
+    case _vector_value:
+        return _any_array_equals(lhs, rhs);
+    default:
+        return false;
+    }
+}
+
+#ifdef OTIO_INSTANCING_SUPPORT
+/*
+ * Writes nothing; a Writer counting references goes through the values
+ * with one of these.
+ */
+class NullEncoder : public Encoder {
+public:
+    void start_object() {}
+    void end_object() {}
+    void start_array(size_t) {}
+    void end_array() {}
+    void write_key(std::string const&) {}
+    void write_null_value() {}
+    void write_value(bool) {}
+    void write_value(int) {}
+    void write_value(int64_t) {}
+    void write_value(uint64_t) {}
+    void write_value(double) {}
+    void write_value(std::string const&) {}
+    void write_value(RationalTime const&) {}
+    void write_value(TimeRange const&) {}
+    void write_value(TimeTransform const&) {}
+    void write_value(SerializableObject::ReferenceId) {}
+};
+
+static std::string _reference_id(std::string const& schema_name, int id) {
+    return schema_name + "-" + std::to_string(id);
 }
+#endif
 
-bool SerializableObject::Writer::write_root(any const& value, Encoder& encoder, ErrorStatus* error_status) {
+bool SerializableObject::Writer::write_root(any const& value, Encoder& encoder, ErrorStatus* error_status,
+                                            int max_threads) {
     Writer w(encoder);
-    w.write(w._no_key, value);
+    w._max_threads = max_threads;
+    w._write_root(value);
     return !encoder.has_errored(error_status);
 }
 
+void SerializableObject::Writer::error(ErrorStatus const& error_status) {
+    _encoder._error(error_status);
+}
+
+void SerializableObject::Writer::_write_root(any const& value) {
+#ifdef OTIO_INSTANCING_SUPPORT
+    {
+        NullEncoder null_encoder;
+        Writer counter(null_encoder);
+        counter._counting_references = true;
+        counter.write(counter._no_key, value);
+
+        for (auto const& e: counter._shared_object_ids) {
+            if (e.second > 1) {
+                _shared_object_ids.emplace(e.first, 0);
+            }
+        }
+    }
+#endif
+
+    write(_no_key, value);
+}
+
 void SerializableObject::Writer::_encoder_write_key(std::string const& key) {
     if (&key != &_no_key) {
         _encoder.write_key(key);
@@ -563,34 +973,43 @@ void SerializableObject::Writer::write(std::string const& key, SerializableObjec
         return;
     }
 
-    auto e = _id_for_object.find(value);
-    if (e != _id_for_object.end()) {
 #ifdef OTIO_INSTANCING_SUPPORT
-        /*
-         * We've already written this value.
-         */
-        _encoder.write_value(SerializableObject::ReferenceId { e->second });
+    if (_counting_references) {
+        if (++_shared_object_ids[value] == 1) {
+            value->write_to(*this);
+        }
+        return;
+    }
+
+    int shared_id = 0;
+    auto e = _shared_object_ids.find(value);
+    if (e != _shared_object_ids.end()) {
+        if (e->second) {
+            /*
+             * We've already written this value.
+             */
+            _encoder.write_value(SerializableObject::ReferenceId {
+                _reference_id(value->_schema_name_for_reference(), e->second) });
+            return;
+        }
+        shared_id = e->second = ++_next_id_for_type[value->_schema_name_for_reference()];
+    }
 #else
+    if (std::find(_objects_in_progress.begin(), _objects_in_progress.end(), value) != _objects_in_progress.end()) {
         /*
-         * We're encountering the same object while it is still
-         * in the map, meaning we're in the middle of writing it out.
+         * We're encountering the same object while we are still
+         * in the middle of writing it out.
          * That's a cycle, as opposed to mere instancing, which we
          * allow so as not to break old allowed behavior.
          */
         std::string s = string_printf("cyclically encountered object has schema %s",
                                       value->schema_name().c_str());
         _encoder._error(ErrorStatus(ErrorStatus::OBJECT_CYCLE, s));
-#endif        
         return;
     }
 
-    std::string const& schema_type_name = value->_schema_name_for_reference();
-    if (_next_id_for_type.find(schema_type_name) == _next_id_for_type.end()) {
-        _next_id_for_type[schema_type_name] = 0;
-    }
-
-    std::string next_id = schema_type_name + "-" + std::to_string(++_next_id_for_type[schema_type_name]);
-    _id_for_object[value] = next_id;
+    _objects_in_progress.push_back(value);
+#endif
 
     _encoder.start_object();
 
@@ -604,18 +1023,17 @@ void SerializableObject::Writer::write(std::string const& key, SerializableObjec
     }
 
 #ifdef OTIO_INSTANCING_SUPPORT
-    _encoder.write_key("OTIO_REF_ID");
-    _encoder.write_value(next_id);
+    if (shared_id) {
+        _encoder.write_key("OTIO_REF_ID");
+        _encoder.write_value(_reference_id(value->_schema_name_for_reference(), shared_id));
+    }
 #endif
     value->write_to(*this);
 
     _encoder.end_object();
 
 #ifndef OTIO_INSTANCING_SUPPORT
-    auto valueEntry = _id_for_object.find(value);
-    if (valueEntry != _id_for_object.end()) {
-        _id_for_object.erase(valueEntry);
-    }
+    _objects_in_progress.pop_back();
 #endif    
 }
 
@@ -624,7 +1042,7 @@ void SerializableObject::Writer::write(std::string const& key, AnyDictionary con
 
     _encoder.start_object();
 
-    for (auto e: value) {
+    for (auto const& e: value) {
         write(e.first, e.second);
     }
 
@@ -636,7 +1054,7 @@ void SerializableObject::Writer::write(std::string const& key, AnyVector const&
 
     _encoder.start_array(value.size());
 
-    for (auto e: value) {
+    for (auto const& e: value) {
         write(_no_key, e);
     }
 
@@ -648,45 +1066,145 @@ void SerializableObject::Writer::write(std::string const& key, any const& value)
 
     _encoder_write_key(key);
 
-    auto e = _write_dispatch_table.find(&type);
-    if (e == _write_dispatch_table.end()) {
+    switch (_value_type(type)) {
+    /*
+     * These are basically atomic writes to the encoder:
+     */
+    case _void_value:
+        _encoder.write_null_value();
+        return;
+    case _bool_value:
+        _encoder.write_value(any_cast<bool>(value));
+        return;
+    case _int64_value:
+        _encoder.write_value(any_cast<int64_t>(value));
+        return;
+    case _double_value:
+        _encoder.write_value(any_cast<double>(value));
+        return;
+    case _string_value:
+        _encoder.write_value(any_cast<std::string const&>(value));
+        return;
+    case _c_string_value:
+        _encoder.write_value(std::string(any_cast<char const*>(value)));
+        return;
+    case _rational_time_value:
+        _encoder.write_value(any_cast<RationalTime const&>(value));
+        return;
+    case _time_range_value:
+        _encoder.write_value(any_cast<TimeRange const&>(value));
+        return;
+    case _time_transform_value:
+        _encoder.write_value(any_cast<TimeTransform const&>(value));
+        return;
+
+    /*
+     * These next recurse back through the Writer itself:
+     */
+    case _retainer_value:
+        this->write(_no_key, any_cast<SerializableObject::Retainer<> const&>(value).value);
+        return;
+    case _dictionary_value:
+        this->write(_no_key, any_cast<AnyDictionary const&>(value));
+        return;
+    case _vector_value: {
         /*
-         * Using the address of a type_info suffers from aliasing across compilation units.
-         * If we fail on a lookup, we fallback on the by_name table, but that's slow because
-         * we have to keep making a string each time.
-         *
-         * So when we fail, we insert the address of the type_info that failed to be found,
-         * so that we'll catch it the next time.  This ensures we fail exactly once per alias
-         * per type while using this writer.
+         * An array of objects is split between threads once it has enough
+         * of them to go round; a shorter one (the tracks of a stack, say) is
+         * written as usual, leaving the arrays inside its objects to be split
+         * instead.
          */
-        auto backup_e = _write_dispatch_table_by_name.find(type.name());
-        if (backup_e != _write_dispatch_table_by_name.end()) {
-            _write_dispatch_table[&type] = backup_e->second;
-            e = _write_dispatch_table.find(&type);
+        AnyVector const& elements = any_cast<AnyVector const&>(value);
+        if (_max_threads > 1 && elements.size() >= size_t(_max_threads) &&
+            _value_type(elements[0].type()) == _retainer_value) {
+            _write_elements_in_parallel(elements);
+        }
+        else {
+            this->write(_no_key, elements);
         }
+        return;
+    }
+    default:
+        break;
     }
 
-    if (e != _write_dispatch_table.end()) {
-        e->second(value);
+    std::string s;
+    std::string bad_type_name = (type == typeid(UnknownType)) ?
+                                 demangled_type_name(any_cast<UnknownType>(value).type_name) :
+                                 demangled_type_name(type);
+        
+    if (&key != &_no_key) {
+        s = string_printf("Encountered object of unknown type '%s' under key '%s'",
+                          bad_type_name.c_str(), key.c_str());
     }
     else {
-        std::string s;
-        std::string bad_type_name = (type == typeid(UnknownType)) ?
-                                     demangled_type_name(any_cast<UnknownType>(value).type_name) :
-                                     demangled_type_name(type);
-            
-        if (&key != &_no_key) {
-            s = string_printf("Encountered object of unknown type '%s' under key '%s'",
-                              bad_type_name.c_str(), key.c_str());
+        s = string_printf("Encountered object of unknown type '%s'",
+                          bad_type_name.c_str());
+    }
+
+    _encoder._error(ErrorStatus(ErrorStatus::TYPE_MISMATCH, s));
+    _encoder.write_null_value();
+}
+
+/*
+ * Writes each element with a Writer and encoder of its own, and then the
+ * encoded elements in order, so that the result is just as it would have
+ * been from one thread.  (An error in an element is passed on to the encoder
+ * here in order, too.)  The element Writers write on their own thread, so
+ * arrays within the elements aren't split up again.
+ */
+void SerializableObject::Writer::_write_elements_in_parallel(AnyVector const& elements) {
+    // objects reached more than once must be numbered in the order written
+    if (elements.size() < 2 || !_encoder.element_encoder() || !_shared_object_ids.empty()) {
+        int max_threads = _max_threads;
+        _max_threads = 1;
+        this->write(_no_key, elements);
+        _max_threads = max_threads;
+        return;
+    }
+
+    /*
+     * Only a few elements per thread are encoded ahead of what has been
+     * passed on, so that memory use doesn't grow with the size of the output.
+     */
+    size_t thread_count = std::min(size_t(_max_threads), elements.size());
+    size_t batch_size = thread_count * 4;
+
+    _encoder.start_array(elements.size());
+    for (size_t begin = 0; begin < elements.size(); begin += batch_size) {
+        size_t end = std::min(elements.size(), begin + batch_size);
+        std::vector<std::unique_ptr<Encoder>> encoders(end - begin);
+        for (auto& e: encoders) {
+            e = _encoder.element_encoder();
         }
-        else {
-            s = string_printf("Encountered object of unknown type '%s'",
-                              bad_type_name.c_str());
+
+        std::atomic<size_t> next_element { begin };
+        auto write_elements = [&]() {
+            for (size_t i = next_element++; i < end; i = next_element++) {
+                Writer w(*encoders[i - begin]);
+                w._objects_in_progress = _objects_in_progress;
+                w.write(w._no_key, elements[i]);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < std::min(thread_count, end - begin); t++) {
+            threads.emplace_back(write_elements);
+        }
+        write_elements();
+        for (auto& t: threads) {
+            t.join();
         }
 
-        _encoder._error(ErrorStatus(ErrorStatus::TYPE_MISMATCH, s));
-        _encoder.write_null_value();
+        for (auto& e: encoders) {
+            _encoder.write_element(*e);
+            if (e->has_errored()) {
+                _encoder._error(e->_error_status);
+            }
+            e.reset();
+        }
     }
+    _encoder.end_array();
 }
 
 bool SerializableObject::is_equivalent_to(SerializableObject const& other) const {
@@ -698,19 +1216,39 @@ bool SerializableObject::is_equivalent_to(SerializableObject const& other) const
     SerializableObject::Writer w1(e1);
     SerializableObject::Writer w2(e2);
 
-    w1.write(w1._no_key, any(Retainer<>(this)));
-    w2.write(w2._no_key, any(Retainer<>(&other)));
+    w1._write_root(any(Retainer<>(this)));
+    w2._write_root(any(Retainer<>(&other)));
 
     return (!e1.has_errored() 
             && !e2.has_errored()
             && w1._any_equals(e1._root, e2._root));
 }
 
-SerializableObject* SerializableObject::clone(ErrorStatus* error_status) const {
+SerializableObject* SerializableObject::clone(ErrorStatus* error_status, bool share_metadata) const {
+    ObjectArena::Scope arena_scope(ObjectArena::enabled());
+
+#ifndef OTIO_INSTANCING_SUPPORT
+    /*
+     * With instancing, shared objects must stay shared in the clone, so
+     * everything goes through the encoder, which keeps track of them.
+     */
+    {
+        Cloner cloner(share_metadata);
+        Retainer<> copy(cloner.clone(this));
+        if (!cloner.failed()) {
+            return copy.take_value();
+        }
+    }
+#endif
+
+    return _clone_by_encoding(error_status);
+}
+
+SerializableObject* SerializableObject::_clone_by_encoding(ErrorStatus* error_status) const {
     CloningEncoder e(true /* actually_clone*/);
     SerializableObject::Writer w(e);
 
-    w.write(w._no_key, any(Retainer<>(this)));
+    w._write_root(any(Retainer<>(this)));
     if (e.has_errored(error_status)) {
         return nullptr;
     }
@@ -727,80 +1265,318 @@ SerializableObject* SerializableObject::clone(ErrorStatus* error_status) const {
         any_cast<SerializableObject::Retainer<>&>(e._root).take_value() : nullptr;
 }
 
-std::string serialize_json_to_string(any const& value, ErrorStatus* error_status, int indent) {
-    OTIO_rapidjson::StringBuffer s;    
-    
+SerializableObject* Cloner::clone(SerializableObject const* source) {
+    if (!source || _failed) {
+        return nullptr;
+    }
+
+    /*
+     * Only the objects being copied right now need checking for cycles:
+     * an object met again once it's done is simply copied again.
+     */
+    if (std::find(_objects_in_progress.begin(), _objects_in_progress.end(), source) !=
+        _objects_in_progress.end()) {
+        _failed = true;
+        return nullptr;
+    }
+
+    auto type_record = source->_type_record();
+    SerializableObject* copy = nullptr;
+
+    _objects_in_progress.push_back(source);
+    if (type_record->copy) {
+        copy = type_record->copy_object(source, *this);
+        // Copying it will have decoded anything lazily read, and if that
+        // failed, the encoder reports it.
+        ErrorStatus error_status;
+        if (copy && source->_undecodable(&error_status)) {
+            _failed = true;
+        }
+    }
+    if (!copy) {
+        ErrorStatus error_status;
+        copy = source->_clone_by_encoding(&error_status);
+        if (!copy || error_status) {
+            _failed = true;
+        }
+    }
+    _objects_in_progress.pop_back();
+    return copy;
+}
+
+AnyDictionary Cloner::clone(AnyDictionary const& source) {
+    AnyDictionary copy;
+    if (source.find("OTIO_SCHEMA") != source.end()) {
+        // The encoder turns this into an object.
+        _failed = true;
+        return copy;
+    }
+
+    copy.reserve(source.size());
+    for (auto const& e: source) {
+        copy.emplace_hint(copy.end(), e.first, clone(e.second));
+    }
+    return copy;
+}
+
+AnyVector Cloner::clone(AnyVector const& source) {
+    AnyVector copy;
+    copy.reserve(source.size());
+    for (auto const& e: source) {
+        copy.push_back(clone(e));
+    }
+    return copy;
+}
+
+static bool _is_copied_as_is(std::type_info const& type) {
+    return type == typeid(std::string) || type == typeid(double) || type == typeid(int64_t) ||
+           type == typeid(bool) || type == typeid(void) || type == typeid(RationalTime) ||
+           type == typeid(TimeRange) || type == typeid(TimeTransform);
+}
+
+any Cloner::clone(any const& source) {
+    std::type_info const& type = source.type();
+
+    if (_is_copied_as_is(type)) {
+        return source;
+    }
+    else if (type == typeid(AnyDictionary)) {
+        return any(clone(any_cast<AnyDictionary const&>(source)));
+    }
+    else if (type == typeid(AnyVector)) {
+        return any(clone(any_cast<AnyVector const&>(source)));
+    }
+    else if (type == typeid(SerializableObject::Retainer<>)) {
+        // As when encoded, a null object becomes a plain null.
+        SerializableObject::Retainer<> copy(clone(any_cast<SerializableObject::Retainer<> const&>(source).value));
+        return copy ? any(copy) : any();
+    }
+    else if (type == typeid(char const*)) {
+        return any(std::string(any_cast<char const*>(source)));
+    }
+
+    _failed = true;
+    return any();
+}
+
+bool Cloner::is_plain(AnyDictionary const& value) {
+    if (value.find("OTIO_SCHEMA") != value.end()) {
+        return false;
+    }
+
+    for (auto const& e: value) {
+        if (!is_plain(e.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Cloner::is_plain(any const& value) {
+    std::type_info const& type = value.type();
+
+    if (_is_copied_as_is(type)) {
+        return true;
+    }
+    else if (type == typeid(AnyDictionary)) {
+        return is_plain(any_cast<AnyDictionary const&>(value));
+    }
+    else if (type == typeid(AnyVector)) {
+        for (auto const& e: any_cast<AnyVector const&>(value)) {
+            if (!is_plain(e)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+/*
+ * A rapidjson output stream that hands on what is written a buffer at a time,
+ * so that no more than one buffer of the output is ever held in memory.  Once
+ * write_chunk fails, the rest is dropped.
+ */
+class _JSONChunkStream {
+public:
+    typedef char Ch;
+
+    _JSONChunkStream(std::function<bool (char const*, size_t)> const& write_chunk, size_t chunk_size)
+        : _write_chunk(write_chunk),
+          _buffer(std::max(chunk_size, size_t(1))),
+          _next(_buffer.data()),
+          _end(_buffer.data() + _buffer.size()),
+          _failed(false) {
+    }
+
+    void Put(char c) {
+        if (_next == _end) {
+            Flush();
+        }
+        *_next++ = c;
+    }
+
+    void Flush() {
+        size_t size = size_t(_next - _buffer.data());
+        if (size && !_failed) {
+            _failed = !_write_chunk(_buffer.data(), size);
+        }
+        _next = _buffer.data();
+    }
+
+    bool failed() const {
+        return _failed;
+    }
+
+private:
+    std::function<bool (char const*, size_t)> const& _write_chunk;
+    std::vector<char> _buffer;
+    char* _next;
+    char* _end;
+    bool _failed;
+};
+
+static size_t const _json_chunk_size = 65536;
+
+template <typename OutputStream>
+static bool _serialize_json(any const& value, OutputStream& output, ErrorStatus* error_status,
+                            int indent, int max_threads) {
     if (indent < 0) {
         OTIO_rapidjson::Writer<
-            decltype(s), 
+            OutputStream,
             OTIO_rapidjson::UTF8<>,
             OTIO_rapidjson::UTF8<>,
             OTIO_rapidjson::CrtAllocator,
             OTIO_rapidjson::kWriteNanAndInfFlag
-            > json_writer(s);
+            > json_writer(output);
         JSONEncoder<decltype(json_writer)> json_encoder(json_writer);
+        return SerializableObject::Writer::write_root(value, json_encoder, error_status, max_threads);
+    }
 
-        if (!SerializableObject::Writer::write_root(value, json_encoder, error_status)) {
-            return std::string();
-        }
+    OTIO_rapidjson::PrettyWriter<
+        OutputStream,
+        OTIO_rapidjson::UTF8<>,
+        OTIO_rapidjson::UTF8<>,
+        OTIO_rapidjson::CrtAllocator,
+        OTIO_rapidjson::kWriteNanAndInfFlag
+        > json_writer(output);
+    JSONEncoder<decltype(json_writer)> json_encoder(json_writer, indent);
+
+    json_writer.SetIndent(' ', indent);
+    return SerializableObject::Writer::write_root(value, json_encoder, error_status, max_threads);
+}
+
+std::string serialize_json_to_string(any const& value, ErrorStatus* error_status, int indent) {
+    std::string result;
+    std::function<bool (char const*, size_t)> append = [&result](char const* data, size_t size) {
+        result.append(data, size);
+        return true;
+    };
+
+    _JSONChunkStream output(append, _json_chunk_size);
+    if (!_serialize_json(value, output, error_status, indent, 1)) {
+        return std::string();
     }
-    else {
-        OTIO_rapidjson::PrettyWriter<
-            decltype(s), 
-            OTIO_rapidjson::UTF8<>,
-            OTIO_rapidjson::UTF8<>,
-            OTIO_rapidjson::CrtAllocator,
-            OTIO_rapidjson::kWriteNanAndInfFlag
-            > json_writer(s);
 
-        JSONEncoder<decltype(json_writer)> json_encoder(json_writer);
+    output.Flush();
+    return result;
+}
 
-        json_writer.SetIndent(' ', indent);
-        if (!SerializableObject::Writer::write_root(value, json_encoder, error_status)) {
-            return std::string();
-        }
+bool serialize_json_to_chunks(any const& value,
+                              std::function<bool (char const* data, size_t size)> const& write_chunk,
+                              ErrorStatus* error_status, int indent, int max_threads) {
+    if (max_threads <= 0) {
+        max_threads = int(std::thread::hardware_concurrency());
+    }
+
+    _JSONChunkStream output(write_chunk, _json_chunk_size);
+    if (!_serialize_json(value, output, error_status, indent, max_threads)) {
+        return false;
     }
 
-    return std::string(s.GetString());
+    output.Flush();
+    if (output.failed()) {
+        *error_status = ErrorStatus(ErrorStatus::FILE_WRITE_FAILED, "could not write JSON output");
+        return false;
+    }
+    return true;
 }
 
 bool serialize_json_to_file(any const& value, std::string const& file_name,
-                            ErrorStatus* error_status, int indent) {
-    std::ofstream os(file_name);
-    if (!os.is_open()) {
+                            ErrorStatus* error_status, int indent, int max_threads) {
+    Compression compression = compression_for_file_name(file_name);
+    if (!compression_supported(compression)) {
+        *error_status = ErrorStatus(ErrorStatus::NOT_IMPLEMENTED,
+                                    string_printf("this build can't write %s compressed files: %s",
+                                                  compression_name(compression), file_name.c_str()));
+        return false;
+    }
+
+    std::FILE* file = std::fopen(file_name.c_str(), compression == Compression::none ? "w" : "wb");
+    if (!file) {
         *error_status = ErrorStatus(ErrorStatus::FILE_WRITE_FAILED, file_name);
         return false;
     }
 
-    OTIO_rapidjson::OStreamWrapper osw(os);
+    // the chunks are already as big as stdio's own buffer would make them
+    std::setvbuf(file, nullptr, _IONBF, 0);
+
+    std::function<bool (char const*, size_t)> write_to_file = [file](char const* data, size_t size) {
+        return std::fwrite(data, 1, size, file) == size;
+    };
+
     bool status;
-    
-    if (indent < 0) {
-        OTIO_rapidjson::Writer<
-            decltype(osw),
-            OTIO_rapidjson::UTF8<>,
-            OTIO_rapidjson::UTF8<>,
-            OTIO_rapidjson::CrtAllocator,
-            OTIO_rapidjson::kWriteNanAndInfFlag
-            > json_writer(osw);
-        JSONEncoder<decltype(json_writer)> json_encoder(json_writer);
-        status = SerializableObject::Writer::write_root(value, json_encoder, error_status);
+    if (compression == Compression::none) {
+        status = serialize_json_to_chunks(value, write_to_file, error_status, indent, max_threads);
     }
     else {
-        OTIO_rapidjson::PrettyWriter<
-            decltype(osw),
-            OTIO_rapidjson::UTF8<>,
-            OTIO_rapidjson::UTF8<>,
-            OTIO_rapidjson::CrtAllocator,
-            OTIO_rapidjson::kWriteNanAndInfFlag
-        > json_writer(osw);
-        JSONEncoder<decltype(json_writer)> json_encoder(json_writer);
-
-        json_writer.SetIndent(' ', indent);
-        status = SerializableObject::Writer::write_root(value, json_encoder, error_status);
+        Compressor compressor(compression, write_to_file);
+        std::function<bool (char const*, size_t)> write_chunk = [&compressor](char const* data, size_t size) {
+            return compressor.write(data, size);
+        };
+        status = serialize_json_to_chunks(value, write_chunk, error_status, indent, max_threads);
+        if (status && !compressor.finish()) {
+            *error_status = ErrorStatus(ErrorStatus::FILE_WRITE_FAILED);
+            status = false;
+        }
     }
 
+    bool closed = (std::fclose(file) == 0);
+    if ((status && !closed) || (!status && error_status->outcome == ErrorStatus::FILE_WRITE_FAILED)) {
+        *error_status = ErrorStatus(ErrorStatus::FILE_WRITE_FAILED, file_name);
+        return false;
+    }
     return status;
 }
 
+std::string serialize_binary_to_string(any const& value, ErrorStatus* error_status, bool object_offsets) {
+    BinaryEncoder binary_encoder(object_offsets);
+    if (!SerializableObject::Writer::write_root(value, binary_encoder, error_status)) {
+        return std::string();
+    }
+
+    return binary_encoder.finish();
+}
+
+bool serialize_binary_to_file(any const& value, std::string const& file_name,
+                              ErrorStatus* error_status, bool object_offsets) {
+    std::ofstream os(file_name, std::ios::binary);
+    if (!os.is_open()) {
+        *error_status = ErrorStatus(ErrorStatus::FILE_WRITE_FAILED, file_name);
+        return false;
+    }
+
+    BinaryEncoder binary_encoder(object_offsets);
+    if (!SerializableObject::Writer::write_root(value, binary_encoder, error_status)) {
+        return false;
+    }
+
+    std::string const& out = binary_encoder.finish();
+    if (!os.write(out.data(), std::streamsize(out.size()))) {
+        *error_status = ErrorStatus(ErrorStatus::FILE_WRITE_FAILED, file_name);
+        return false;
+    }
+    return true;
+}
+
 } }
@@ -4,13 +4,39 @@
 #include "opentimelineio/any.h"
 #include "opentimelineio/errorStatus.h"
 
+#include <functional>
 #include <string>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
 std::string serialize_json_to_string(const any& value, ErrorStatus* error_status, int indent = 4);
 
+// Files named with a .gz or .zst extension are gzip or zstd compressed, if
+// this build supports it (see compression.h).
+//
+// With max_threads other than 1, arrays of at least that many objects (the
+// timelines of a SerializableCollection, or the clips of a track, say) have
+// their elements encoded in parallel by up to that many threads, 0 meaning
+// one per core; the file is the same either way.  Objects whose Python
+// wrappers are alive must then not be written while the caller holds the GIL.
 bool serialize_json_to_file(const any& value, std::string const& file_name,
-                            ErrorStatus* error_status, int indent = 4);
+                            ErrorStatus* error_status, int indent = 4, int max_threads = 1);
+
+// Hands the JSON to write_chunk a piece at a time, as it is produced, so that
+// it can be compressed or sent on without the whole document ever being held
+// in memory.  Once write_chunk returns false the rest is dropped, and the
+// call fails with FILE_WRITE_FAILED.
+bool serialize_json_to_chunks(const any& value,
+                              std::function<bool (char const* data, size_t size)> const& write_chunk,
+                              ErrorStatus* error_status, int indent = 4, int max_threads = 1);
+
+// The compact binary form laid out in binaryFormat.h.  With object_offsets
+// set, it ends with the offset of every object, so that a reader can seek
+// straight to any one of them.
+std::string serialize_binary_to_string(const any& value, ErrorStatus* error_status,
+                                       bool object_offsets = false);
+
+bool serialize_binary_to_file(const any& value, std::string const& file_name,
+                              ErrorStatus* error_status, bool object_offsets = false);
 
 } }
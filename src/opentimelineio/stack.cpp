@@ -12,6 +12,10 @@ Stack::Stack(
     : Parent( name, source_range, metadata, effects, markers) {
 }
 
+Stack::Stack(Stack const& source, Cloner& cloner)
+    : Parent(source, cloner) {
+}
+
 Stack::~Stack() {
 }
 
@@ -21,6 +21,8 @@ public:
             std::vector<Effect*> const& effects = std::vector<Effect*>(),
             std::vector<Marker*> const& markers = std::vector<Marker*>());
 
+    Stack(Stack const& source, Cloner& cloner);
+
     virtual TimeRange range_of_child_at_index(int index, ErrorStatus* error_status) const;
     virtual TimeRange trimmed_range_of_child_at_index(int index, ErrorStatus* error_status) const;
     virtual TimeRange available_range(ErrorStatus* error_status) const;
@@ -8,6 +8,10 @@ TimeEffect::TimeEffect(std::string const& name,
     : Parent(name, effect_name, metadata) {
 }
 
+TimeEffect::TimeEffect(TimeEffect const& source, Cloner& cloner)
+    : Parent(source, cloner) {
+}
+
 TimeEffect::~TimeEffect() {
 }
 
@@ -17,6 +17,8 @@ public:
     TimeEffect(std::string const& name = std::string(),
                std::string const& effect_name = std::string(),
                AnyDictionary const& metadata = AnyDictionary());
+
+    TimeEffect(TimeEffect const& source, Cloner& cloner);
 protected:
     virtual ~TimeEffect();
 
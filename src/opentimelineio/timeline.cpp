@@ -10,6 +10,12 @@ Timeline::Timeline(std::string const& name,
       _tracks(new Stack("tracks")) {
 }
 
+Timeline::Timeline(Timeline const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _global_start_time(source._global_start_time),
+      _tracks(cloner.clone(source._tracks)) {
+}
+
 Timeline::~Timeline() {
 }
 
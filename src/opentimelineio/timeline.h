@@ -20,6 +20,8 @@ public:
              optional<RationalTime> global_start_time = nullopt,
              AnyDictionary const& metadata = AnyDictionary());
 
+    Timeline(Timeline const& source, Cloner& cloner);
+
     Stack* tracks() const {
         return _tracks;
     }
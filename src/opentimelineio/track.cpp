@@ -1,8 +1,11 @@
 #include "opentimelineio/track.h"
 #include "opentimelineio/transition.h"
 #include "opentimelineio/gap.h"
+#include "opentimelineio/mediaReference.h"
 #include "opentimelineio/vectorIndexing.h"
 
+#include <algorithm>
+
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
 Track::Track(std::string const& name,
@@ -13,6 +16,11 @@ Track::Track(std::string const& name,
       _kind(kind) {
 }
 
+Track::Track(Track const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _kind(source._kind) {
+}
+
 Track::~Track() {
 }
 
@@ -58,23 +66,197 @@ TimeRange Track::range_of_child_at_index(int index, ErrorStatus* error_status) c
         return TimeRange();
     }
     
-    RationalTime start_time(0, child_duration.rate());
+    RationalTime start_time;
+    if (!_child_start_time(index, child_duration.rate(), &start_time, error_status)) {
+        return TimeRange();
+    }
     
-    for (int i = 0; i < index; i++) {
-        Composable* child2 = children()[i].value;
-        if (!child2->overlapping()) {
-            start_time += _safe_duration(children()[i].value, error_status);
+    if (auto transition = dynamic_cast<Transition*>(child)) {
+        start_time -= transition->in_offset();
+    }
+    
+    return TimeRange(start_time, child_duration);
+}
+
+bool Track::_update_child_start_times(size_t count, ErrorStatus* error_status) const {
+    if (_child_start_times_generation != MediaReference::available_range_generation()) {
+        _child_start_times_generation = MediaReference::available_range_generation();
+        _valid_child_start_times = 0;
+        _first_timed_child = -1;
+        _first_earlier_child_start_time = 0;
+    }
+
+    _child_start_times.resize(children().size() + 1);
+    for (size_t i = _valid_child_start_times; i <= count; i++) {
+        if (i == 0) {
+            _child_start_times[0] = RationalTime();
+            _valid_child_start_times = 1;
+            continue;
+        }
+
+        Composable* child = children()[i - 1].value;
+        RationalTime& sum = _child_start_times[i];
+        if (child->overlapping()) {
+            sum = _child_start_times[i - 1];
+        }
+        else {
+            RationalTime duration = _safe_duration(child, error_status);
+            if (*error_status) {
+                return false;
+            }
+
+            if (_first_timed_child < 0) {
+                _first_timed_child = int(i - 1);
+                sum = RationalTime(0, duration.rate());
+            }
+            else {
+                sum = _child_start_times[i - 1];
+            }
+            sum += duration;
+            if (_first_earlier_child_start_time == 0 && sum < _child_start_times[i - 1]) {
+                _first_earlier_child_start_time = i;
+            }
+        }
+        _valid_child_start_times = i + 1;
+    }
+    return true;
+}
+
+bool Track::_child_start_time(int index, double rate, RationalTime* start_time,
+                              ErrorStatus* error_status) const {
+    // decoded first, so that a lazy load isn't finished with the lock held
+    children();
+    std::lock_guard<std::mutex> lock(_child_start_times_mutex);
+
+    if (!_update_child_start_times(size_t(index), error_status)) {
+        return false;
+    }
+
+    if (_first_timed_child < 0 || _first_timed_child >= index) {
+        *start_time = RationalTime(0, rate);
+        return true;
+    }
+
+    /*
+     * The sums are accumulated at the rate of the first timed child.  Any
+     * other rate for the child asked about (bar a slower, valid one) changes
+     * how the floating point sum rounds, so add it up from scratch to give
+     * exactly the same answer as the uncached walk.
+     */
+    double sum_rate = _child_start_times[_first_timed_child + 1].rate();
+    if (!(rate == sum_rate || (0 < rate && rate < sum_rate))) {
+        *start_time = RationalTime(0, rate);
+        for (int i = 0; i < index; i++) {
+            Composable* child = children()[i].value;
+            if (!child->overlapping()) {
+                *start_time += _safe_duration(child, error_status);
+            }
+            if (*error_status) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    *start_time = _child_start_times[index];
+    return true;
+}
+
+std::pair<int, int> Track::child_index_bounds(TimeRange search_range, ErrorStatus* error_status) const {
+    // decoded first, so that a lazy load isn't finished with the lock held
+    children();
+    std::lock_guard<std::mutex> lock(_child_start_times_mutex);
+
+    auto none = std::make_pair(0, -1);
+
+    /*
+     * The start times are only sorted if no child has a negative duration,
+     * which can't be known without looking at them all.  If one has, fall
+     * back to letting the caller check every child.
+     */
+    size_t n = children().size();
+    if (!_update_child_start_times(n, error_status)) {
+        return none;
+    }
+    if (_first_earlier_child_start_time != 0) {
+        return std::make_pair(0, int(n) - 1);
+    }
+
+    RationalTime start_time = search_range.start_time();
+    RationalTime end_time = search_range.end_time_exclusive();
+    auto begin = _child_start_times.begin(), end = begin + n + 1;
+    int first = int(std::upper_bound(begin + 1, end, start_time) - begin) - 1;
+    int last = int(std::upper_bound(begin, end, end_time) - begin) - 1;
+
+    /*
+     * An overlapping child (a transition) hangs over the timed children on
+     * either side of it, and the cached sums may round differently from
+     * range_of_child_at_index(), so widen the bounds to take in the previous
+     * and next children that take up time and anything in between.
+     */
+    auto takes_up_time = [this](int index) {
+        return _child_start_times[index] < _child_start_times[index + 1];
+    };
+
+    for (int timed = 0; first > 0 && timed < 2; first--) {
+        timed += takes_up_time(first - 1);
+    }
+    for (int timed = 0; last < int(n) - 1 && timed < 2; last++) {
+        timed += takes_up_time(last + 1);
+    }
+    
+    return std::make_pair(std::max(first, 0), std::min(last, int(n) - 1));
+}
+
+std::vector<int> Track::_child_indices_at_time(RationalTime search_time,
+                                               ErrorStatus* error_status) const {
+    std::vector<int> result;
+    
+    auto bounds = child_index_bounds(TimeRange(search_time), error_status);
+    
+    for (int i = bounds.first; i <= bounds.second; i++) {
+        if (range_of_child_at_index(i, error_status).contains(search_time)) {
+            result.push_back(i);
+            break;
         }
         if (*error_status) {
-            return TimeRange();
+            break;
         }
     }
     
-    if (auto transition = dynamic_cast<Transition*>(child)) {
-        start_time -= transition->in_offset();
+    return result;
+}
+
+std::vector<int> Track::_child_indices_in_range(TimeRange search_range,
+                                                ErrorStatus* error_status) const {
+    std::vector<int> result;
+    
+    auto bounds = child_index_bounds(search_range, error_status);
+    
+    for (int i = bounds.first; i <= bounds.second; i++) {
+        if (range_of_child_at_index(i, error_status).intersects(search_range)) {
+            result.push_back(i);
+        }
+        if (*error_status) {
+            break;
+        }
     }
     
-    return TimeRange(start_time, child_duration);
+    return result;
+}
+
+opentime::TimeRangeArray Track::range_array_of_children(double rate, ErrorStatus* error_status) const {
+    opentime::TimeRangeArray result(rate);
+    result.reserve(children().size());
+    
+    for (size_t i = 0; i < children().size(); i++) {
+        result.push_back(range_of_child_at_index(int(i), error_status));
+        if (*error_status) {
+            return opentime::TimeRangeArray(rate);
+        }
+    }
+    
+    return result;
 }
 
 TimeRange Track::trimmed_range_of_child_at_index(int index, ErrorStatus* error_status) const {
@@ -214,4 +396,21 @@ bool Track::_overlaping_children() const {
     return false;
 }
 
+void Track::_child_timing_changed(int index) {
+    {
+        std::lock_guard<std::mutex> lock(_child_start_times_mutex);
+
+        // the sums up to and including the changed child are unaffected
+        _valid_child_start_times = std::min(_valid_child_start_times, size_t(std::max(index, 0)) + 1);
+        if (_first_timed_child >= index) {
+            _first_timed_child = -1;
+        }
+        if (_first_earlier_child_start_time >= _valid_child_start_times) {
+            _first_earlier_child_start_time = 0;
+        }
+    }
+
+    Parent::_child_timing_changed(index);
+}
+
 } }
@@ -2,6 +2,9 @@
 
 #include "opentimelineio/version.h"
 #include "opentimelineio/composition.h"
+#include "opentime/timeRangeArray.h"
+
+#include <mutex>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
 
@@ -29,6 +32,8 @@ public:
           std::string const& = Kind::video,
           AnyDictionary const& metadata = AnyDictionary());
 
+    Track(Track const& source, Cloner& cloner);
+
     std::string const& kind() const {
         return _kind;
     }
@@ -49,6 +54,16 @@ public:
 
     virtual std::map<Composable*, TimeRange> range_of_all_children(ErrorStatus* error_status) const;
 
+    // The range of each child in order, as range_of_child_at_index() gives
+    // it, rescaled to rate and gathered up for testing all at once.
+    opentime::TimeRangeArray range_array_of_children(double rate, ErrorStatus* error_status) const;
+
+    // The first and last index of the children that may overlap search_range
+    // (first > last if none can), found by binary search.  Children outside
+    // these bounds are known not to overlap it; those inside still need
+    // checking against range_of_child_at_index().
+    std::pair<int, int> child_index_bounds(TimeRange search_range, ErrorStatus* error_status) const;
+
 protected:
     virtual ~Track();
     virtual std::string const& composition_kind() const;
@@ -58,8 +73,38 @@ protected:
 
     virtual bool _overlaping_children() const;
 
+    virtual std::vector<int> _child_indices_at_time(RationalTime search_time,
+                                                    ErrorStatus* error_status) const;
+    virtual std::vector<int> _child_indices_in_range(TimeRange search_range,
+                                                     ErrorStatus* error_status) const;
+
+    virtual void _child_timing_changed(int index);
+
 private:
+    // Brings the first count + 1 entries of _child_start_times up to date.
+    // The caller must hold _child_start_times_mutex.
+    bool _update_child_start_times(size_t count, ErrorStatus* error_status) const;
+
+    bool _child_start_time(int index, double rate, RationalTime* start_time,
+                           ErrorStatus* error_status) const;
+
     std::string _kind;
+
+    // Running sums of the durations of the non-overlapping children, so
+    // that range_of_child_at_index() doesn't have to walk all earlier
+    // siblings: _child_start_times[i] is the sum over children [0, i).
+    // Only the first _valid_child_start_times entries are up to date; the
+    // rest are recomputed on demand after an edit.
+    mutable std::vector<RationalTime> _child_start_times;
+    mutable size_t _valid_child_start_times = 0;
+    mutable int _first_timed_child = -1;
+
+    // The first i for which _child_start_times[i] comes before the entry
+    // preceding it, because a child has a negative duration, or 0 if there
+    // is none among the valid entries.
+    mutable size_t _first_earlier_child_start_time = 0;
+    mutable uint64_t _child_start_times_generation = 0;
+    mutable std::mutex _child_start_times_mutex;
 };
 
 } }
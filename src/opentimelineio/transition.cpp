@@ -14,6 +14,13 @@ Transition::Transition(std::string const& name,
       _out_offset(out_offset) {
 }
 
+Transition::Transition(Transition const& source, Cloner& cloner)
+    : Parent(source, cloner),
+      _transition_type(source._transition_type),
+      _in_offset(source._in_offset),
+      _out_offset(source._out_offset) {
+}
+
 Transition::~Transition() {
 }
 
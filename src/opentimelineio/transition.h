@@ -25,6 +25,8 @@ public:
                RationalTime out_offset = RationalTime(),
                AnyDictionary const& metadata = AnyDictionary());
 
+    Transition(Transition const& source, Cloner& cloner);
+
     virtual bool overlapping() const;
 
     std::string transition_type() const {
@@ -41,6 +43,7 @@ public:
     
     void set_in_offset(RationalTime in_offset) {
         _in_offset = in_offset;
+        _timing_changed();
     }
 
     RationalTime out_offset() const {
@@ -49,6 +52,7 @@ public:
     
     void set_out_offset(RationalTime out_offset) {
         _out_offset = out_offset;
+        _timing_changed();
     }
 
     // XX is this virtual?
@@ -45,7 +45,7 @@ TypeRegistry::TypeRegistry() {
                   [] () {
                       fatal_error("UnknownSchema should not be created from type registry");
                       return nullptr;
-                  }, "UnknownSchema");
+                  }, "UnknownSchema", _copy_function<UnknownSchema>(0));
 
     register_type<Clip>();
     register_type<Composable>();
@@ -82,8 +82,9 @@ TypeRegistry::TypeRegistry() {
      */
     register_upgrade_function(Marker::Schema::name, 2,
                               [](AnyDictionary* d) {
-                                  (*d)["marked_range"] = (*d)["range"];
+                                  any range = std::move((*d)["range"]);
                                   d->erase("range");
+                                  (*d)["marked_range"] = std::move(range);
                               });
 
     // -- Event System
@@ -95,12 +96,14 @@ bool
 TypeRegistry::register_type(std::string const& schema_name, int schema_version,
                             std::type_info const* type, 
                             std::function<SerializableObject* ()> create,
-                            std::string const& class_name)
+                            std::string const& class_name,
+                            std::function<SerializableObject* (SerializableObject const*, Cloner&)> copy,
+                            int lazy_fields)
 {
     std::lock_guard<std::mutex> lock(_registry_mutex);
 
     if (!_find_type_record(schema_name)) {
-        _TypeRecord* r = new _TypeRecord { schema_name, schema_version, class_name, create };
+        _TypeRecord* r = new _TypeRecord { schema_name, schema_version, class_name, create, copy, lazy_fields };
         _type_records[schema_name] = r;
         if (type) {
             _type_records_by_type_name[type->name()] = r;
@@ -117,7 +120,8 @@ TypeRegistry::register_type_from_existing_type(std::string const& schema_name, i
     std::lock_guard<std::mutex> lock(_registry_mutex);
     if (auto r = _find_type_record(existing_schema_name)) {
         if (!_find_type_record(schema_name)) {
-            _type_records[schema_name] = new _TypeRecord { r->schema_name, r->schema_version, r->class_name, r->create };
+            _type_records[schema_name] = new _TypeRecord { r->schema_name, r->schema_version, r->class_name,
+                                                             r->create, r->copy, r->lazy_fields };
             return true;
         }
 
@@ -146,6 +150,14 @@ bool TypeRegistry::register_upgrade_function(std::string const& schema_name,
     return false;
 }
 
+int TypeRegistry::_lazy_fields_for_schema(std::string const& schema_name, int schema_version) {
+    _TypeRecord const* type_record = _lookup_type_record(schema_name);
+    if (!type_record || type_record->schema_version != schema_version) {
+        return 0;
+    }
+    return type_record->lazy_fields;
+}
+
 SerializableObject* TypeRegistry::_instance_from_schema(std::string schema_name,
                                                         int schema_version,
                                                         AnyDictionary& dict,
@@ -221,6 +233,14 @@ SerializableObject* TypeRegistry::_TypeRecord::create_object() const {
     so->_set_type_record(this);
     return so;
 }
+
+SerializableObject* TypeRegistry::_TypeRecord::copy_object(SerializableObject const* source, Cloner& cloner) const {
+    SerializableObject* so = copy(source, cloner);
+    if (so) {
+        so->_set_type_record(this);
+    }
+    return so;
+}
     
 bool TypeRegistry::set_type_record(SerializableObject* so, std::string const& schema_name,
                                     ErrorStatus* error_status) {
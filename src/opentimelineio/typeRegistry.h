@@ -9,11 +9,17 @@
 #include <map>
 #include <algorithm>
 #include <mutex>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 
 namespace opentimelineio { namespace OPENTIMELINEIO_VERSION  {
     
 class SerializableObject;
+class SerializableObjectWithMetadata;
+class Composition;
 class AnyDictionary;
+class Cloner;
 
 class TypeRegistry {
 public:
@@ -21,6 +27,11 @@ public:
     // Accesses to its functions are thread-safe.
     static TypeRegistry& instance();
 
+    // What a lazy load (see deserialize_json_from_file()) may leave undecoded
+    // in instances of a type: the children of a Composition, the metadata of
+    // a SerializableObjectWithMetadata.
+    enum LazyFields { lazy_children = 1, lazy_metadata = 2 };
+
     // Register a new schema.
     //
     // This API call should only be needed by developers who are creating a bridge
@@ -28,23 +39,37 @@ public:
     // the templated form of this call.
     //
     // If the specified schema_name has already been registered, this function does nothing and returns false.
+    //
+    // If given, copy is used by SerializableObject::clone() to copy an instance
+    // directly (see Cloner); otherwise, instances are cloned by way of their
+    // serialized form.
+    //
+    // lazy_fields is a combination of LazyFields, saying which the instances
+    // create returns have.
     bool register_type(std::string const& schema_name,
                        int schema_version,
                        std::type_info const* type,
                        std::function<SerializableObject* ()> create,
-                       std::string const& class_name = "");
+                       std::string const& class_name = "",
+                       std::function<SerializableObject* (SerializableObject const*, Cloner&)> copy = nullptr,
+                       int lazy_fields = 0);
 
     // Register a new SerializableObject class
     //
     // If the specified schema_name has already been registered, this function does nothing and returns false.
     // If you need to provide an alias for a schema name, se register_type_from_existing_type().
+    //
+    // If CLASS has a clone constructor, CLASS(CLASS const&, Cloner&), clone() uses it.
     template <typename CLASS>
     bool register_type() {
         return register_type(CLASS::Schema::name,
                              CLASS::Schema::version,
                              &typeid(CLASS),
                              []() -> SerializableObject* { return new CLASS; },
-                             CLASS::Schema::name);
+                             CLASS::Schema::name,
+                             _copy_function<CLASS>(0),
+                             (std::is_base_of<Composition, CLASS>::value ? lazy_children : 0) |
+                             (std::is_base_of<SerializableObjectWithMetadata, CLASS>::value ? lazy_metadata : 0));
     }
 
     // Register a new schema.
@@ -99,26 +124,52 @@ private:
     TypeRegistry(TypeRegistry const&) = delete;
     TypeRegistry& operator=(TypeRegistry const&) = delete;
 
+    using _CopyFunction = std::function<SerializableObject* (SerializableObject const*, Cloner&)>;
+
+    // Chosen when CLASS has a clone constructor.  It only copies instances of
+    // CLASS itself, leaving anything else (say, an instance of a subclass given
+    // CLASS's schema) to be cloned by way of its serialized form.
+    template <typename CLASS>
+    static auto _copy_function(int)
+        -> decltype(new CLASS(std::declval<CLASS const&>(), std::declval<Cloner&>()), _CopyFunction()) {
+        return [](SerializableObject const* source, Cloner& cloner) -> SerializableObject* {
+            return typeid(*source) == typeid(CLASS) ?
+                new CLASS(*static_cast<CLASS const*>(source), cloner) : nullptr;
+        };
+    }
+
+    template <typename CLASS>
+    static _CopyFunction _copy_function(long) {
+        return nullptr;
+    }
+
     class _TypeRecord {
         std::string schema_name;
         int schema_version;
         std::string class_name;
         std::function<SerializableObject* ()> create;
+        _CopyFunction copy;
+        int lazy_fields;
         
         std::map<int, std::function<void (AnyDictionary*)>> upgrade_functions;
         
         _TypeRecord(std::string _schema_name, int _schema_version,
-                    std::string _class_name, std::function<SerializableObject* ()> _create) {
+                    std::string _class_name, std::function<SerializableObject* ()> _create,
+                    _CopyFunction _copy = nullptr, int _lazy_fields = 0) {
             this->schema_name = _schema_name;
             this->schema_version = _schema_version;
             this->class_name = _class_name;
             this->create = _create;
+            this->copy = _copy;
+            this->lazy_fields = _lazy_fields;
         }
         
         SerializableObject* create_object() const;
+        SerializableObject* copy_object(SerializableObject const* source, Cloner& cloner) const;
         
         friend class TypeRegistry;
         friend class SerializableObject;
+        friend class Cloner;
     };
     
     // helper functions for lookup
@@ -127,6 +178,10 @@ private:
         return it == _type_records.end() ? nullptr : it->second;
     }
 
+    // The LazyFields of the type registered for schema_name, or 0 if there
+    // is none or schema_version isn't the version registered.
+    int _lazy_fields_for_schema(std::string const& schema_name, int schema_version);
+
     SerializableObject* _instance_from_schema(std::string schema_name,
                                               int schema_version,
                                               AnyDictionary& dict,
@@ -142,6 +197,7 @@ private:
     std::map<std::string, _TypeRecord*> _type_records_by_type_name;
 
     friend class SerializableObject;
+    friend class JSONDecoder;
 };
 
 } }
@@ -7,6 +7,13 @@ UnknownSchema::UnknownSchema(std::string const& original_schema_name, int origin
       _original_schema_version(original_schema_version) {
 }
 
+UnknownSchema::UnknownSchema(UnknownSchema const& source, Cloner& cloner)
+    : SerializableObject(source, cloner),
+      _original_schema_name(source._original_schema_name),
+      _original_schema_version(source._original_schema_version),
+      _data(cloner.clone(source._data)) {
+}
+
 UnknownSchema::~UnknownSchema() {
 }
 
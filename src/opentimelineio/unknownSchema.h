@@ -14,6 +14,8 @@ public:
 
     UnknownSchema(std::string const& original_schema_name, int original_schema_version);
 
+    UnknownSchema(UnknownSchema const& source, Cloner& cloner);
+
     std::string const& original_schema_name() const {
         return _original_schema_name;
     }
@@ -5,5 +5,7 @@ PYBIND11_MODULE(_opentime, m) {
     m.doc() = "Bindings to C++ OTIO implementation";
     opentime_rationalTime_bindings(m);
     opentime_timeRange_bindings(m);
+    opentime_timeRangeArray_bindings(m);
     opentime_timeTransform_bindings(m);
+    opentime_exactTime_bindings(m);
 }
@@ -7,7 +7,24 @@
 
 void opentime_rationalTime_bindings(pybind11::module);
 void opentime_timeRange_bindings(pybind11::module);
+void opentime_timeRangeArray_bindings(pybind11::module);
 void opentime_timeTransform_bindings(pybind11::module);
+void opentime_exactTime_bindings(pybind11::module);
+
+struct ErrorStatusConverter {
+    operator opentime::ErrorStatus* () {
+        return &error_status;
+    }
+    
+    ~ErrorStatusConverter() noexcept(false) {
+        namespace py = pybind11;
+        if (error_status) {
+            throw py::value_error(error_status.details);
+        }
+    }
+
+    opentime::ErrorStatus error_status;
+};
 
 std::string opentime_python_str(opentime::RationalTime rt);
 std::string opentime_python_repr(opentime::RationalTime rt);
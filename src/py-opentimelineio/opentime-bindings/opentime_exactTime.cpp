@@ -0,0 +1,118 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/operators.h>
+
+#include "opentime_bindings.h"
+#include "opentime/exactTimeRange.h"
+#include "opentime/stringPrintf.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+using namespace opentime;
+
+static std::string exact_time_python_str(ExactTime t) {
+    return t.rate_denominator() == 1 ?
+        string_printf("ExactTime(%lld, %d)", (long long) t.value(), t.rate_numerator()) :
+        string_printf("ExactTime(%lld, %d/%d)", (long long) t.value(), t.rate_numerator(), t.rate_denominator());
+}
+
+static std::string exact_time_python_repr(ExactTime t) {
+    return string_printf("otio.opentime.ExactTime(value=%lld, rate_numerator=%d, rate_denominator=%d)",
+                         (long long) t.value(), t.rate_numerator(), t.rate_denominator());
+}
+
+void opentime_exactTime_bindings(py::module m) {
+    py::class_<ExactTime>(m, "ExactTime", R"docstring(
+A whole number of ticks at a rate that is a ratio of whole numbers, such as
+24000/1001.  Unlike RationalTime, arithmetic and comparison are exact.
+)docstring")
+        .def(py::init<int64_t, int32_t, int32_t>(), "value"_a = 0, "rate_numerator"_a = 1, "rate_denominator"_a = 1)
+        .def("is_invalid_time", &ExactTime::is_invalid_time)
+        .def_property_readonly("value", &ExactTime::value)
+        .def_property_readonly("rate_numerator", &ExactTime::rate_numerator)
+        .def_property_readonly("rate_denominator", &ExactTime::rate_denominator)
+        .def_property_readonly("rate", &ExactTime::rate)
+        .def("to_seconds", &ExactTime::to_seconds)
+        .def("to_rational_time", &ExactTime::to_rational_time)
+        .def_static("from_rational_time", [](RationalTime time) {
+                return ExactTime::from_rational_time(time, ErrorStatusConverter());
+            }, "time"_a)
+        .def("__copy__", [](ExactTime t, py::object) {
+                return t;
+            }, "copier"_a = py::none())
+        .def("__deepcopy__", [](ExactTime t, py::object) {
+                return t;
+            }, "copier"_a = py::none())
+        .def("__str__", &exact_time_python_str)
+        .def("__repr__", &exact_time_python_repr)
+        .def(- py::self)
+        .def(py::self + py::self)
+        .def(py::self - py::self)
+        .def(py::self < py::self)
+        .def(py::self > py::self)
+        .def(py::self <= py::self)
+        .def(py::self >= py::self)
+        .def(py::self == py::self)
+        .def(py::self != py::self);
+
+    py::class_<ExactTimeRange>(m, "ExactTimeRange", R"docstring(
+The exact counterpart of TimeRange.  Its predicates take no epsilon_s.
+)docstring")
+        .def(py::init(
+                    [](ExactTime* start_time, ExactTime* duration) {
+                    if (start_time == nullptr && duration == nullptr) {
+                        return ExactTimeRange();
+                    }
+                    else if (start_time == nullptr) {
+                        return ExactTimeRange(
+                            ExactTime(0, duration->rate_numerator(), duration->rate_denominator()),
+                            *duration
+                        );
+                    }
+                    // duration == nullptr
+                    else if (duration == nullptr) {
+                        return ExactTimeRange(*start_time);
+                    }
+                    else {
+                        return ExactTimeRange(*start_time, *duration);
+                    }
+        }), "start_time"_a=nullptr, "duration"_a=nullptr)
+        .def_property_readonly("start_time", &ExactTimeRange::start_time)
+        .def_property_readonly("duration", &ExactTimeRange::duration)
+        .def("end_time_exclusive", &ExactTimeRange::end_time_exclusive)
+        .def("to_time_range", &ExactTimeRange::to_time_range)
+        .def_static("from_time_range", [](TimeRange range) {
+                return ExactTimeRange::from_time_range(range, ErrorStatusConverter());
+            }, "range"_a)
+        .def("contains", (bool (ExactTimeRange::*)(ExactTime) const) &ExactTimeRange::contains, "other"_a)
+        .def("contains", (bool (ExactTimeRange::*)(ExactTimeRange) const) &ExactTimeRange::contains, "other"_a)
+        .def("overlaps", (bool (ExactTimeRange::*)(ExactTime) const) &ExactTimeRange::overlaps, "other"_a)
+        .def("overlaps", (bool (ExactTimeRange::*)(ExactTimeRange) const) &ExactTimeRange::overlaps, "other"_a)
+        .def("before", (bool (ExactTimeRange::*)(ExactTime) const) &ExactTimeRange::before, "other"_a)
+        .def("before", (bool (ExactTimeRange::*)(ExactTimeRange) const) &ExactTimeRange::before, "other"_a)
+        .def("meets", &ExactTimeRange::meets, "other"_a)
+        .def("begins", (bool (ExactTimeRange::*)(ExactTime) const) &ExactTimeRange::begins, "other"_a)
+        .def("begins", (bool (ExactTimeRange::*)(ExactTimeRange) const) &ExactTimeRange::begins, "other"_a)
+        .def("finishes", (bool (ExactTimeRange::*)(ExactTime) const) &ExactTimeRange::finishes, "other"_a)
+        .def("finishes", (bool (ExactTimeRange::*)(ExactTimeRange) const) &ExactTimeRange::finishes, "other"_a)
+        .def("intersects", &ExactTimeRange::intersects, "other"_a)
+        .def("__copy__", [](ExactTimeRange r) {
+                return r;
+            })
+        .def("__deepcopy__", [](ExactTimeRange r, py::object memo) {
+                return r;
+            })
+        .def_static("range_from_start_end_time", &ExactTimeRange::range_from_start_end_time,
+                    "start_time"_a, "end_time_exclusive"_a)
+        .def(py::self == py::self)
+        .def(py::self != py::self)
+        .def("__str__", [](ExactTimeRange r) {
+                return string_printf("ExactTimeRange(%s, %s)",
+                                     exact_time_python_str(r.start_time()).c_str(),
+                                     exact_time_python_str(r.duration()).c_str());
+            })
+        .def("__repr__", [](ExactTimeRange r) {
+                return string_printf("otio.opentime.ExactTimeRange(start_time=%s, duration=%s)",
+                                     exact_time_python_repr(r.start_time()).c_str(),
+                                     exact_time_python_repr(r.duration()).c_str());
+            });
+}
@@ -1,6 +1,8 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/operators.h>
+#include <pybind11/stl.h>
 
+#include "opentime_bindings.h"
 #include "opentime/rationalTime.h"
 #include "opentimelineio/stringUtils.h"
 
@@ -10,21 +12,6 @@ using namespace pybind11::literals;
 using namespace opentime;
 
 namespace {
-struct ErrorStatusConverter {
-    operator ErrorStatus* () {
-        return &error_status;
-    }
-    
-    ~ErrorStatusConverter() noexcept(false) {
-        namespace py = pybind11;
-        if (error_status) {
-            throw py::value_error(error_status.details);
-        }
-    }
-
-    ErrorStatus error_status;
-};
-
 IsDropFrameRate df_enum_converter(py::object& df) {
     if (df.is(py::none())) {
         return IsDropFrameRate::InferFromRate;
@@ -110,6 +97,19 @@ void opentime_rationalTime_bindings(py::module m) {
         .def_static("from_timecode", [](std::string s, double rate) {
                 return RationalTime::from_timecode(s, rate, ErrorStatusConverter());
             }, "timecode"_a, "rate"_a)
+        .def_static("from_timecodes", [](std::vector<std::string> const& timecodes, double rate) {
+                std::vector<RationalTime> times(timecodes.size());
+                RationalTime::from_timecodes(timecodes.data(), timecodes.size(), rate, times.data(),
+                                             ErrorStatusConverter());
+                return times;
+            }, "timecodes"_a, "rate"_a)
+        .def_static("to_timecodes", [](std::vector<RationalTime> const& times, double rate,
+                                       py::object drop_frame) {
+                std::vector<std::string> timecodes(times.size());
+                RationalTime::to_timecodes(times.data(), times.size(), rate, df_enum_converter(drop_frame),
+                                           timecodes.data(), ErrorStatusConverter());
+                return timecodes;
+            }, "times"_a, "rate"_a, "drop_frame"_a = py::none())
         .def_static("from_time_string", [](std::string s, double rate) {
                 return RationalTime::from_time_string(s, rate, ErrorStatusConverter());
             }, "time_string"_a, "rate"_a)
@@ -0,0 +1,66 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "opentime_bindings.h"
+#include "opentime/timeRangeArray.h"
+#include "opentime/stringPrintf.h"
+
+#include <memory>
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+using namespace opentime;
+
+// Runs relation over ranges, and hands back its results as a list of bools.
+template <typename Relation>
+static std::vector<bool> _results_of(TimeRangeArray const& ranges, Relation relation) {
+    std::unique_ptr<bool[]> results(new bool[ranges.size()]);
+    relation(results.get());
+    return std::vector<bool>(results.get(), results.get() + ranges.size());
+}
+
+void opentime_timeRangeArray_bindings(py::module m) {
+    py::class_<TimeRangeArray>(m, "TimeRangeArray", R"docstring(
+Many TimeRanges at one rate, for testing against all at once.  Each relation
+returns a list with what the TimeRange method of the same name gives for
+each range.
+)docstring")
+        .def(py::init([](std::vector<TimeRange> const& ranges, double rate) {
+                return TimeRangeArray(ranges, rate);
+            }), "ranges"_a = std::vector<TimeRange>(), "rate"_a = 1)
+        .def_property_readonly("rate", &TimeRangeArray::rate)
+        .def_property_readonly("start_values", &TimeRangeArray::start_values)
+        .def_property_readonly("duration_values", &TimeRangeArray::duration_values)
+        .def("__len__", &TimeRangeArray::size)
+        .def("__getitem__", [](TimeRangeArray const& ranges, int index) {
+                if (index < 0) {
+                    index += int(ranges.size());
+                }
+                if (index < 0 || index >= int(ranges.size())) {
+                    throw py::index_error();
+                }
+                return ranges.range(size_t(index));
+            }, "index"_a)
+        .def("append", &TimeRangeArray::push_back, "range"_a)
+        .def("contains", [](TimeRangeArray const& ranges, RationalTime other) {
+                return _results_of(ranges, [&](bool* results) { ranges.contains(other, results); });
+            }, "other"_a)
+        .def("contains", [](TimeRangeArray const& ranges, TimeRange other, double epsilon_s) {
+                return _results_of(ranges, [&](bool* results) { ranges.contains(other, results, epsilon_s); });
+            }, "other"_a, "epsilon_s"_a = DEFAULT_EPSILON_s)
+        .def("overlaps", [](TimeRangeArray const& ranges, RationalTime other) {
+                return _results_of(ranges, [&](bool* results) { ranges.overlaps(other, results); });
+            }, "other"_a)
+        .def("overlaps", [](TimeRangeArray const& ranges, TimeRange other, double epsilon_s) {
+                return _results_of(ranges, [&](bool* results) { ranges.overlaps(other, results, epsilon_s); });
+            }, "other"_a, "epsilon_s"_a = DEFAULT_EPSILON_s)
+        .def("intersects", [](TimeRangeArray const& ranges, TimeRange other, double epsilon_s) {
+                return _results_of(ranges, [&](bool* results) { ranges.intersects(other, results, epsilon_s); });
+            }, "other"_a, "epsilon_s"_a = DEFAULT_EPSILON_s)
+        .def("clamped_by", &TimeRangeArray::clamped_by, "window"_a)
+        .def("extent", &TimeRangeArray::extent)
+        .def("__repr__", [](TimeRangeArray const& ranges) {
+                return string_printf("otio.opentime.TimeRangeArray(<%zu ranges>, rate=%g)",
+                                     ranges.size(), ranges.rate());
+            });
+}
@@ -18,14 +18,16 @@ struct AnyDictionaryProxy : public AnyDictionary::MutationStamp {
     }
 
     struct Iterator {
-        Iterator(MutationStamp& s)
+        Iterator(MutationStamp& s, AnyDictionary const& d)
             : mutation_stamp(s),
-              it(s.any_dictionary->begin()),
+              any_dictionary(d),
+              it(d.begin()),
               starting_stamp { s.stamp } {
         }
 
         MutationStamp& mutation_stamp;
-        AnyDictionary::iterator it;
+        AnyDictionary const& any_dictionary;
+        AnyDictionary::const_iterator it;
         int64_t starting_stamp;
     
         Iterator* iter() {
@@ -39,7 +41,7 @@ struct AnyDictionaryProxy : public AnyDictionary::MutationStamp {
             else if (mutation_stamp.stamp != starting_stamp) {
                 throw py::value_error("container mutated during iteration");
             }
-            else if (it == mutation_stamp.any_dictionary->end()) {
+            else if (it == any_dictionary.end()) {
                 throw py::stop_iteration();
             }
 
@@ -50,12 +52,19 @@ struct AnyDictionaryProxy : public AnyDictionary::MutationStamp {
     };
 
     py::object get_item(std::string const& key) {
-        AnyDictionary& m = fetch_any_dictionary();
+        AnyDictionary const& m = fetch_any_dictionary_for_reading();
 
         auto e = m.find(key);
         if (e == m.end()) {
             throw py::key_error(key);
         }
+
+        // dictionaries and lists are handed out to be written through, so
+        // they can't come from a shared copy
+        std::type_info const& type = e->second.type();
+        if (&m != any_dictionary && (type == typeid(AnyDictionary) || type == typeid(AnyVector))) {
+            e = fetch_any_dictionary().find(key);
+        }
         return any_to_py(e->second);
     }
 
@@ -80,19 +89,30 @@ struct AnyDictionaryProxy : public AnyDictionary::MutationStamp {
     }
 
     int len() {
-        return int(fetch_any_dictionary().size());
+        return int(fetch_any_dictionary_for_reading().size());
     }
     
     Iterator* iter() {
-        (void) fetch_any_dictionary();
-        return new Iterator(*this);
+        return new Iterator(*this, fetch_any_dictionary_for_reading());
     }
 
     AnyDictionary& fetch_any_dictionary() const {
         if (!any_dictionary) {
             throw_dictionary_was_deleted();
         }
+        if (shared) {
+            unshare();
+        }
         return *any_dictionary;
     }
+
+    // Unlike fetch_any_dictionary(), doesn't take a copy of metadata that
+    // clone() has left shared.
+    AnyDictionary const& fetch_any_dictionary_for_reading() const {
+        if (!any_dictionary) {
+            throw_dictionary_was_deleted();
+        }
+        return shared ? *shared : *any_dictionary;
+    }
 };
 
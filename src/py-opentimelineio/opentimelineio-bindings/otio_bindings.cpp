@@ -6,6 +6,7 @@
 #include "otio_errorStatusHandler.h"
 #include "opentimelineio/serialization.h"
 #include "opentimelineio/deserialization.h"
+#include "opentimelineio/objectArena.h"
 #include "opentimelineio/serializableObject.h"
 #include "opentimelineio/typeRegistry.h"
 #include "opentimelineio/stackAlgorithm.h"
@@ -33,8 +34,20 @@ static void register_python_type(py::object class_object,
             return r.take_value();
     };
 
+    // what a lazy load can leave undecoded is known from the class, without
+    // making an instance of it to see
+    py::object otio = py::module::import("opentimelineio._otio");
+    int lazy_fields = 0;
+    if (PyObject_IsSubclass(class_object.ptr(), otio.attr("Composition").ptr()) == 1) {
+        lazy_fields |= TypeRegistry::lazy_children;
+    }
+    if (PyObject_IsSubclass(class_object.ptr(), otio.attr("SerializableObjectWithMetadata").ptr()) == 1) {
+        lazy_fields |= TypeRegistry::lazy_metadata;
+    }
+
     TypeRegistry::instance().register_type(schema_name, schema_version,
-                                           nullptr, create, schema_name);
+                                           nullptr, create, schema_name,
+                                           nullptr, lazy_fields);
 }
 
 static bool register_upgrade_function(std::string const& schema_name,
@@ -79,9 +92,13 @@ PYBIND11_MODULE(_otio, m) {
               return serialize_json_to_string(pyAny->a, ErrorStatusHandler(), indent);
           }, "value"_a, "indent"_a)
      .def("_serialize_json_to_file",
-          [](PyAny* pyAny, std::string filename, int indent) {
-              return serialize_json_to_file(pyAny->a, filename, ErrorStatusHandler(), indent);
-          }, "value"_a, "filename"_a, "indent"_a)
+          [](PyAny* pyAny, std::string filename, int indent, int max_threads) {
+              // the writing threads take the GIL to let go of Python's
+              // wrappers, and errors must be raised with it held
+              ErrorStatusHandler error_status;
+              py::gil_scoped_release release;
+              return serialize_json_to_file(pyAny->a, filename, error_status, indent, max_threads);
+          }, "value"_a, "filename"_a, "indent"_a, "max_threads"_a = 1)
      .def("deserialize_json_from_string",
           [](std::string input) {
               any result;
@@ -89,9 +106,36 @@ PYBIND11_MODULE(_otio, m) {
               return any_to_py(result, true /*top_level*/);
           }, "input"_a)
      .def("deserialize_json_from_file",
+          [](std::string filename, bool lazy, int max_threads) {
+              any result;
+              {
+                  // the decoding threads take the GIL to make objects of
+                  // types defined in Python, and errors must be raised with
+                  // it held
+                  ErrorStatusHandler error_status;
+                  py::gil_scoped_release release;
+                  deserialize_json_from_file(filename, &result, error_status, max_threads, lazy);
+              }
+              return any_to_py(result, true /*top_level*/);
+          }, "filename"_a, "lazy"_a = false, "max_threads"_a = 1)
+     .def("_serialize_binary_to_string",
+          [](PyAny* pyAny, bool object_offsets) {
+              return py::bytes(serialize_binary_to_string(pyAny->a, ErrorStatusHandler(), object_offsets));
+          }, "value"_a, "object_offsets"_a)
+     .def("_serialize_binary_to_file",
+          [](PyAny* pyAny, std::string filename, bool object_offsets) {
+              return serialize_binary_to_file(pyAny->a, filename, ErrorStatusHandler(), object_offsets);
+          }, "value"_a, "filename"_a, "object_offsets"_a)
+     .def("deserialize_binary_from_string",
+          [](py::bytes input) {
+              any result;
+              deserialize_binary_from_string(std::string(input), &result, ErrorStatusHandler());
+              return any_to_py(result, true /*top_level*/);
+          }, "input"_a)
+     .def("deserialize_binary_from_file",
           [](std::string filename) {
               any result;
-              deserialize_json_from_file(filename, &result, ErrorStatusHandler());
+              deserialize_binary_from_file(filename, &result, ErrorStatusHandler());
               return any_to_py(result, true /*top_level*/);
           }, "filename"_a);
 
@@ -127,6 +171,9 @@ PYBIND11_MODULE(_otio, m) {
           "so"_a, "apply_now"_a);
     m.def("instance_from_schema", &instance_from_schema,
           "schema_name"_a, "schema_version"_a, "data"_a);
+    m.def("set_object_arena_enabled", &ObjectArena::set_enabled, "enabled"_a);
+    m.def("object_arena_enabled", &ObjectArena::enabled);
+    m.def("object_arena_live_blocks", &ObjectArena::live_blocks);
     m.def("register_upgrade_function", &register_upgrade_function,
           "schema_name"_a,
           "version_to_upgrade_to"_a,
@@ -46,6 +46,10 @@ ErrorStatusHandler::~ErrorStatusHandler() noexcept(false) {
         throw py::value_error("Illegal/malformed schema: " + details());
     case ErrorStatus::JSON_PARSE_ERROR:
         throw py::value_error("JSON parse error while reading: " + details());
+    case ErrorStatus::BINARY_PARSE_ERROR:
+        throw py::value_error("Binary parse error while reading: " + details());
+    case ErrorStatus::COMPRESSION_ERROR:
+        throw py::value_error("Decompression error while reading: " + details());
     case ErrorStatus::FILE_OPEN_FAILED:
         throw py::value_error("failed to open file for reading: " + details());
     case ErrorStatus::FILE_WRITE_FAILED:
@@ -113,8 +113,9 @@ static void define_bases1(py::module m) {
                 auto ptr = s->dynamic_fields().get_or_create_mutation_stamp();
                 return (AnyDictionaryProxy*)(ptr); }, py::return_value_policy::take_ownership)
         .def("is_equivalent_to", &SerializableObject::is_equivalent_to, "other"_a.none(false))
-        .def("clone", [](SerializableObject* so) {
-                return so->clone(ErrorStatusHandler()); })
+        .def("clone", [](SerializableObject* so, bool share_metadata) {
+                return so->clone(ErrorStatusHandler(), share_metadata); },
+            "share_metadata"_a = false)
         .def("to_json_string", [](SerializableObject* so, int indent) {
                 return so->to_json_string(ErrorStatusHandler(), indent); },
             "indent"_a = 4)
@@ -122,9 +123,18 @@ static void define_bases1(py::module m) {
                 return so->to_json_file(file_name, ErrorStatusHandler(), indent); },
             "file_name"_a,
             "indent"_a = 4)
-        .def_static("from_json_file", [](std::string file_name) {
-                return SerializableObject::from_json_file(file_name, ErrorStatusHandler()); },
-            "file_name"_a)
+        .def_static("from_json_file", [](std::string file_name, int max_threads, bool lazy) {
+                SerializableObject* result;
+                {
+                    // as for deserialize_json_from_file
+                    ErrorStatusHandler error_status;
+                    py::gil_scoped_release release;
+                    result = SerializableObject::from_json_file(file_name, error_status, max_threads, lazy);
+                }
+                return result; },
+            "file_name"_a,
+            "max_threads"_a = 1,
+            "lazy"_a = false)
         .def_static("from_json_string", [](std::string input) {
                 return SerializableObject::from_json_string(input, ErrorStatusHandler());
             },
@@ -145,7 +155,7 @@ static void define_bases1(py::module m) {
             name_arg,
             metadata_arg)
         .def_property_readonly("metadata", [](SOWithMetadata* s) {
-                auto ptr = s->metadata().get_or_create_mutation_stamp();
+                auto ptr = s->metadata_mutation_stamp();
             return (AnyDictionaryProxy*)(ptr); }, py::return_value_policy::take_ownership)
         .def_property("name", [](SOWithMetadata* so) {
                 return plain_string(so->name());
@@ -282,6 +292,9 @@ static void define_items_and_compositions(py::module m) {
         .def("range_in_parent", [](Item* item) {
             return item->range_in_parent(ErrorStatusHandler());
             })
+        .def("transform_to_root", [](Item* item) {
+            return item->transform_to_root(ErrorStatusHandler());
+            })
         .def("transformed_time", [](Item* item, RationalTime t, Item* to_item) {
             return item->transformed_time(t, to_item, ErrorStatusHandler());
             }, "time"_a, "to_item"_a)
@@ -399,6 +412,20 @@ static void define_items_and_compositions(py::module m) {
                 }
                 return d;
             })
+        .def("children_at_time", [](Composition* c, RationalTime search_time, bool shallow_search) {
+                py::list l;
+                for (auto child: c->children_at_time(search_time, ErrorStatusHandler(), shallow_search)) {
+                    l.append(py::cast(child.value));
+                }
+                return l;
+            }, "search_time"_a, "shallow_search"_a = false)
+        .def("children_in_range", [](Composition* c, TimeRange search_range, bool shallow_search) {
+                py::list l;
+                for (auto child: c->children_in_range(search_range, ErrorStatusHandler(), shallow_search)) {
+                    l.append(py::cast(child.value));
+                }
+                return l;
+            }, "search_range"_a, "shallow_search"_a = false)
         .def("handles_of_child", [](Composition* c, Composable* child) {
                 auto result = c->handles_of_child(child, ErrorStatusHandler());
                 return py::make_tuple(py::cast(result.first), py::cast(result.second));
@@ -460,7 +487,10 @@ static void define_items_and_compositions(py::module m) {
         .def("neighbors_of", [](Track* t, Composable* item, Track::NeighborGapPolicy policy) {
                 auto result =  t->neighbors_of(item, ErrorStatusHandler(), policy);
                 return py::make_tuple(py::cast(result.first.take_value()), py::cast(result.second.take_value()));
-            }, "item"_a, "policy"_a = Track::NeighborGapPolicy::never);
+            }, "item"_a, "policy"_a = Track::NeighborGapPolicy::never)
+        .def("range_array_of_children", [](Track* t, double rate) {
+                return t->range_array_of_children(rate, ErrorStatusHandler());
+            }, "rate"_a);
 
     py::class_<Track::Kind>(track_class, "Kind")
         .def_property_readonly_static("Audio", [](py::object /* self */) { return Track::Kind::audio; })
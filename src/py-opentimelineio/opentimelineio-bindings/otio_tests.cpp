@@ -1,15 +1,67 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/operators.h>
 
+#include "opentime/rationalTime.h"
+#include "opentime/timeRange.h"
+#include "opentimelineio/deserialization.h"
+#include "opentimelineio/objectArena.h"
 #include "opentimelineio/serializableObject.h"
 #include "opentimelineio/serializableObjectWithMetadata.h"
 #include "opentimelineio/serializableCollection.h"
+#include "opentimelineio/serialization.h"
 #include "opentimelineio/timeline.h"
 #include "otio_utils.h"
 
 namespace py = pybind11;
 using namespace pybind11::literals;
 
+/*
+ * opentime's value types are meant to be usable in constant expressions;
+ * this fails to compile if any of what's checked stops being so.
+ */
+namespace constexpr_checks {
+
+using opentime::OPENTIME_VERSION::RationalTime;
+using opentime::OPENTIME_VERSION::TimeRange;
+
+constexpr RationalTime one_second(24, 24);
+constexpr RationalTime half_second(1, 2);
+constexpr TimeRange first_second(RationalTime(0, 24), one_second);
+
+// arithmetic, which takes the higher of the two rates
+static_assert((one_second + half_second).value() == 36 && (one_second + half_second).rate() == 24, "+");
+static_assert((one_second - half_second) == RationalTime(12, 24), "-");
+static_assert((-half_second).value() == -1, "unary -");
+static_assert(half_second < one_second && one_second >= half_second && half_second != one_second, "comparison");
+
+// rescaling
+static_assert(half_second.rescaled_to(48) == RationalTime(24, 48), "rescaled_to");
+static_assert(half_second.value_rescaled_to(one_second) == 12, "value_rescaled_to");
+static_assert(one_second.to_frames(30) == 30 && one_second.to_seconds() == 1, "to_frames, to_seconds");
+static_assert(RationalTime::duration_from_start_end_time(half_second, one_second) == RationalTime(1, 2),
+              "duration_from_start_end_time");
+
+// the TimeRange predicates
+static_assert(first_second.end_time_exclusive() == one_second, "end_time_exclusive");
+static_assert(first_second.contains(half_second) && !first_second.contains(one_second), "contains(RationalTime)");
+static_assert(first_second.contains(TimeRange(RationalTime(1, 24), RationalTime(12, 24))), "contains(TimeRange)");
+static_assert(first_second.overlaps(TimeRange(half_second, one_second)), "overlaps");
+static_assert(first_second.before(TimeRange(RationalTime(2, 1), one_second)), "before");
+static_assert(first_second.meets(TimeRange(one_second, one_second)), "meets");
+static_assert(TimeRange(RationalTime(0, 24), half_second).begins(first_second), "begins");
+static_assert(TimeRange(half_second, half_second).finishes(first_second), "finishes");
+static_assert(TimeRange::range_from_start_end_time(RationalTime(0, 24), one_second) == first_second,
+              "range_from_start_end_time");
+
+// the rate tables
+static_assert(RationalTime::is_valid_timecode_rate(24) && RationalTime::is_valid_timecode_rate(30000.0 / 1001.0),
+              "is_valid_timecode_rate");
+static_assert(!RationalTime::is_valid_timecode_rate(23) && !RationalTime::is_valid_timecode_rate(-24),
+              "is_valid_timecode_rate on others");
+static_assert(RationalTime::is_dropframe_rate(29.97) && !RationalTime::is_dropframe_rate(24), "is_dropframe_rate");
+
+}
+
 class TestObject : public SerializableObjectWithMetadata {
 public:
     struct Schema {
@@ -151,6 +203,257 @@ bool test_big_uint() {
     return true;
 }
 
+/// test that objects created in an ObjectArena::Scope share a block, which
+/// goes once the last of them does, and that later scopes get fresh blocks
+bool test_object_arena() {
+    size_t const blocks = ObjectArena::live_blocks();
+    std::vector<SerializableObject::Retainer<>> objects;
+    {
+        ObjectArena::Scope scope;
+        for (int i = 0; i < 4; i++) {
+            objects.emplace_back(new SerializableObjectWithMetadata());
+        }
+    }
+    if (ObjectArena::live_blocks() != blocks + 1) {
+        return false;
+    }
+
+    for (size_t i = 1; i < objects.size(); i++) {
+        if (objects[i].value <= objects[i - 1].value) {
+            return false;
+        }
+    }
+
+    // the first object keeps the whole block alive
+    objects.resize(1);
+    if (ObjectArena::live_blocks() != blocks + 1) {
+        return false;
+    }
+    objects.clear();
+    if (ObjectArena::live_blocks() != blocks) {
+        return false;
+    }
+
+    {
+        ObjectArena::Scope scope;
+        objects.emplace_back(new SerializableObjectWithMetadata());
+    }
+    if (ObjectArena::live_blocks() != blocks + 1) {
+        return false;
+    }
+    objects.clear();
+
+    // outside a scope, objects are allocated on their own
+    objects.emplace_back(new SerializableObjectWithMetadata());
+    bool result = ObjectArena::live_blocks() == blocks;
+    objects.clear();
+    return result && ObjectArena::live_blocks() == blocks;
+}
+
+/// test that a value of each type Writer knows survives a round trip
+/// through JSON, and that values of a type it doesn't know fail to write,
+/// the second time round as well (when the type is no longer looked up by
+/// name, but remembered)
+bool test_writer_value_types() {
+    SerializableObject::Retainer<> so(new SerializableObjectWithMetadata("so"));
+    RationalTime rt(5, 24);
+    TimeRange tr(rt, RationalTime(10, 24));
+    TimeTransform tt(rt, 2, 30);
+
+    AnyDictionary values;
+    values["void"] = any();
+    values["bool"] = any(true);
+    values["int64"] = any(int64_t(1) << 40);
+    values["double"] = any(0.25);
+    values["string"] = any(std::string("string"));
+    values["c_string"] = any(static_cast<char const*>("c_string"));
+    values["rational_time"] = any(rt);
+    values["time_range"] = any(tr);
+    values["time_transform"] = any(tt);
+    values["retainer"] = any(so);
+    values["dictionary"] = any(AnyDictionary { { "key", any(int64_t(1)) } });
+    values["vector"] = any(AnyVector { any(int64_t(1)), any(std::string("2")) });
+
+    ErrorStatus error_status;
+    std::string encoded = serialize_json_to_string(any(values), &error_status);
+    any decoded_any;
+    if (error_status || !deserialize_json_from_string(encoded, &decoded_any, &error_status) ||
+        decoded_any.type() != typeid(AnyDictionary)) {
+        return false;
+    }
+
+    AnyDictionary const& decoded = any_cast<AnyDictionary const&>(decoded_any);
+    auto value = [&](char const* key) -> any const& { return decoded.at(key); };
+    if (decoded.size() != values.size() ||
+        !value("void").empty() ||
+        any_cast<bool>(value("bool")) != true ||
+        any_cast<int64_t>(value("int64")) != int64_t(1) << 40 ||
+        any_cast<double>(value("double")) != 0.25 ||
+        any_cast<std::string>(value("string")) != "string" ||
+        any_cast<std::string>(value("c_string")) != "c_string" ||
+        any_cast<RationalTime>(value("rational_time")) != rt ||
+        any_cast<TimeRange>(value("time_range")) != tr ||
+        any_cast<TimeTransform>(value("time_transform")) != tt ||
+        any_cast<SerializableObject::Retainer<>>(value("retainer")).value->to_json_string(&error_status) !=
+            so.value->to_json_string(&error_status) ||
+        any_cast<int64_t>(any_cast<AnyDictionary const&>(value("dictionary")).at("key")) != 1 ||
+        any_cast<AnyVector const&>(value("vector")).size() != 2 ||
+        any_cast<std::string>(any_cast<AnyVector const&>(value("vector"))[1]) != "2") {
+        return false;
+    }
+
+    // A ReferenceId is written straight to the encoder by the object it
+    // stands for; as a value, like an int, it's a type Writer doesn't know.
+    for (auto const& unknown: { any(int(1)), any(SerializableObject::ReferenceId { "1" }) }) {
+        error_status = ErrorStatus();
+        serialize_json_to_string(any(AnyVector { unknown, unknown }), &error_status);
+        if (error_status.outcome != ErrorStatus::TYPE_MISMATCH) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t _occurrences(std::string const& s, std::string const& what) {
+    size_t count = 0;
+    for (size_t i = s.find(what); i != std::string::npos; i = s.find(what, i + 1)) {
+        count++;
+    }
+    return count;
+}
+
+/// test that only objects reached more than once are given an OTIO_REF_ID
+/// (with instancing support; without it, none are), and what becomes of an
+/// object that contains itself
+bool test_reference_ids() {
+    using SOWithMetadata = SerializableObjectWithMetadata;
+    SerializableObject::Retainer<SOWithMetadata> root(new SOWithMetadata("root"));
+    SerializableObject::Retainer<> shared(new SOWithMetadata("shared"));
+    root.value->metadata()["first"] = shared;
+    root.value->metadata()["second"] = shared;
+    root.value->metadata()["single"] = SerializableObject::Retainer<>(new SOWithMetadata("single"));
+
+    ErrorStatus error_status;
+    std::string encoded = root.value->to_json_string(&error_status);
+    if (error_status) {
+        return false;
+    }
+
+#ifdef OTIO_INSTANCING_SUPPORT
+    SerializableObject::Retainer<SOWithMetadata> decoded(
+        dynamic_cast<SOWithMetadata*>(SerializableObject::from_json_string(encoded, &error_status)));
+    if (_occurrences(encoded, "OTIO_REF_ID") != 1 ||
+        _occurrences(encoded, "SerializableObjectRef") != 1 ||
+        !decoded ||
+        any_cast<SerializableObject::Retainer<>>(decoded.value->metadata()["first"]).value !=
+            any_cast<SerializableObject::Retainer<>>(decoded.value->metadata()["second"]).value) {
+        return false;
+    }
+#else
+    if (_occurrences(encoded, "OTIO_REF_ID") != 0 ||
+        _occurrences(encoded, "\"shared\"") != 2) {
+        return false;
+    }
+#endif
+
+    // written as a reference to itself with instancing support, and
+    // otherwise an error
+    root.value->metadata()["self"] = SerializableObject::Retainer<>(root.value);
+    root.value->to_json_string(&error_status);
+    root.value->metadata().erase("self");
+#ifdef OTIO_INSTANCING_SUPPORT
+    return !error_status;
+#else
+    return error_status.outcome == ErrorStatus::OBJECT_CYCLE;
+#endif
+}
+
+/// test that clones made sharing metadata share one copy of it with the
+/// original and with each other, until one of them writes to it
+bool test_shared_metadata() {
+    SerializableObject::Retainer<SerializableObjectWithMetadata> original(
+        new SerializableObjectWithMetadata("original"));
+    original.value->metadata()["key"] = std::string("value");
+
+    ErrorStatus error_status;
+    std::vector<SerializableObject::Retainer<SerializableObjectWithMetadata>> clones;
+    for (int i = 0; i < 3; i++) {
+        clones.emplace_back(dynamic_cast<SerializableObjectWithMetadata*>(
+                                original.value->clone(&error_status, true)));
+        if (!clones.back()) {
+            return false;
+        }
+    }
+
+    auto const_metadata = [](SerializableObjectWithMetadata const* so) -> AnyDictionary const& {
+        return so->metadata();
+    };
+    AnyDictionary const* shared = &const_metadata(original.value);
+    for (auto& clone: clones) {
+        if (&const_metadata(clone.value) != shared) {
+            return false;
+        }
+    }
+
+    // the one writing takes a copy of its own, and the rest go on sharing
+    clones[0].value->metadata()["key"] = std::string("changed");
+    if (&const_metadata(clones[0].value) == shared ||
+        &const_metadata(original.value) != shared ||
+        &const_metadata(clones[1].value) != shared ||
+        &const_metadata(clones[2].value) != shared) {
+        return false;
+    }
+
+    return any_cast<std::string>(const_metadata(clones[0].value).at("key")) == "changed" &&
+        any_cast<std::string>(const_metadata(original.value).at("key")) == "value" &&
+        any_cast<std::string>(const_metadata(clones[1].value).at("key")) == "value";
+}
+
+/// test that JSON too big for one chunk is handed over in several, which
+/// together are what serialize_json_to_string gives, and that once a chunk
+/// can't be written no more are offered and the call fails
+bool test_json_chunks() {
+    SerializableObject::Retainer<SerializableCollection> collection(new SerializableCollection("collection"));
+    for (int i = 0; i < 2000; i++) {
+        SerializableObjectWithMetadata* so = new SerializableObjectWithMetadata(string_printf("object %d", i));
+        so->metadata()["index"] = int64_t(i);
+        collection.value->insert_child(i, so);
+    }
+
+    ErrorStatus error_status;
+    std::string expected = collection.value->to_json_string(&error_status);
+    if (error_status || expected.size() < 3 * 65536) {
+        return false;
+    }
+
+    std::string written;
+    size_t chunk_count = 0;
+    bool status = serialize_json_to_chunks(
+        any(SerializableObject::Retainer<>(collection)),
+        [&](char const* data, size_t size) {
+            chunk_count++;
+            written.append(data, size);
+            return size <= 65536;
+        }, &error_status);
+    if (!status || chunk_count < 3 || written != expected) {
+        return false;
+    }
+
+    SerializableObject::Retainer<> decoded(SerializableObject::from_json_string(written, &error_status));
+    if (!decoded || decoded.value->to_json_string(&error_status) != expected) {
+        return false;
+    }
+
+    chunk_count = 0;
+    status = serialize_json_to_chunks(
+        any(SerializableObject::Retainer<>(collection)),
+        [&](char const*, size_t) {
+            chunk_count++;
+            return false;
+        }, &error_status);
+    return !status && chunk_count == 1 && error_status.outcome == ErrorStatus::FILE_WRITE_FAILED;
+}
+
 void otio_tests_bindings(py::module m) {
     TypeRegistry& r = TypeRegistry::instance();
     r.register_type<TestObject>();
@@ -168,4 +471,9 @@ void otio_tests_bindings(py::module m) {
     test.def("gil_scoping", &test_gil_scoping);
     test.def("xyzzy", &otio_xyzzy);
     test.def("test_big_uint", &test_big_uint);
+    test.def("test_object_arena", &test_object_arena);
+    test.def("test_writer_value_types", &test_writer_value_types);
+    test.def("test_reference_ids", &test_reference_ids);
+    test.def("test_json_chunks", &test_json_chunks);
+    test.def("test_shared_metadata", &test_shared_metadata);
 }
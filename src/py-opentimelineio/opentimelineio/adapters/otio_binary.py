@@ -0,0 +1,90 @@
+#
+# Copyright Contributors to the OpenTimelineIO project
+#
+# Licensed under the Apache License, Version 2.0 (the "Apache License")
+# with the following modification; you may not use this file except in
+# compliance with the Apache License and the following modification to it:
+# Section 6. Trademarks. is deleted and replaced with:
+#
+# 6. Trademarks. This License does not grant permission to use the trade
+#    names, trademarks, service marks, or product names of the Licensor
+#    and its affiliates, except as required to comply with Section 4(c) of
+#    the License and to reproduce the content of the NOTICE file.
+#
+# You may obtain a copy of the Apache License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the Apache License with the above modification is
+# distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied. See the Apache License for the specific
+# language governing permissions and limitations under the Apache License.
+#
+
+"""This adapter lets you read and write .otiob files, a compact binary form
+of .otio files that is quicker to read and write"""
+
+from .. import (
+    core
+)
+
+
+def read_from_file(filepath):
+    """
+    De-serializes an OpenTimelineIO object from a binary file
+
+    Args:
+        filepath (str): The path to an otiob file to read from
+
+    Returns:
+        OpenTimeline: An OpenTimeline object
+    """
+    return core.deserialize_binary_from_file(filepath)
+
+
+def read_from_string(input_str):
+    """
+    De-serializes an OpenTimelineIO object from binary data
+
+    Args:
+        input_str (bytes): The binary serialized otio contents
+
+    Returns:
+        OpenTimeline: An OpenTimeline object
+    """
+    return core.deserialize_binary_from_string(input_str)
+
+
+def write_to_string(input_otio, object_offsets=False):
+    """
+    Serializes an OpenTimelineIO object into binary data
+
+    Args:
+        input_otio (OpenTimeline): An OpenTimeline object
+        object_offsets (bool): Also write the offset of every object, so
+            that readers can seek straight to one
+
+    Returns:
+        bytes: The binary serialized representation
+    """
+    return core.serialize_binary_to_string(input_otio, object_offsets)
+
+
+def write_to_file(input_otio, filepath, object_offsets=False):
+    """
+    Serializes an OpenTimelineIO object into a binary file
+
+    Args:
+        input_otio (OpenTimeline): An OpenTimeline object
+        filepath (str): The name of an otiob file to write to
+        object_offsets (bool): Also write the offset of every object, so
+            that readers can seek straight to one
+
+    Returns:
+        bool: Write success
+
+    Raises:
+        ValueError: on write error
+    """
+    return core.serialize_binary_to_file(input_otio, filepath, object_offsets)
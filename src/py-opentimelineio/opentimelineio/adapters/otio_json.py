@@ -32,17 +32,26 @@ from .. import (
 # @TODO: Implement out of process plugins that hand around JSON
 
 
-def read_from_file(filepath):
+def read_from_file(filepath, lazy=False, max_threads=1):
     """
     De-serializes an OpenTimelineIO object from a file
 
     Args:
-        filepath (str): The path to an otio file to read from
+        filepath (str): The path to an otio file to read from, which may be
+            gzip or zstd compressed
+        lazy (bool): Leave the children of compositions and the metadata of
+            objects undecoded until they are first accessed.  What then
+            fails to decode is left out, and writing or cloning the objects
+            it was part of raises the error.
+        max_threads (int): The number of threads to decode the children of
+            the root object, such as the timelines of a collection, with; 0
+            uses one per core.  The result, or the error, is the same
+            whatever the number.
 
     Returns:
         OpenTimeline: An OpenTimeline object
     """
-    return core.deserialize_json_from_file(filepath)
+    return core.deserialize_json_from_file(filepath, lazy, max_threads)
 
 
 def read_from_string(input_str):
@@ -73,16 +82,20 @@ def write_to_string(input_otio, indent=4):
     return core.serialize_json_to_string(input_otio, indent)
 
 
-def write_to_file(input_otio, filepath, indent=4):
+def write_to_file(input_otio, filepath, indent=4, max_threads=1):
     """
     Serializes an OpenTimelineIO object into a file
 
     Args:
 
         input_otio (OpenTimeline): An OpenTimeline object
-        filepath (str): The name of an otio file to write to
+        filepath (str): The name of an otio file to write to; a .gz or .zst
+            extension compresses it with gzip or zstd
         indent (int): number of spaces for each json indentation level.\
             Use -1 for no indentation or newlines.
+        max_threads (int): number of threads to encode large arrays of\
+            objects, such as the clips of a track, with; 0 uses one per\
+            core.  The file is the same whatever the number.
 
     Returns:
         bool: Write success
@@ -90,4 +103,9 @@ def write_to_file(input_otio, filepath, indent=4):
     Raises:
         ValueError: on write error
     """
-    return core.serialize_json_to_file(input_otio, filepath, indent)
+    return core.serialize_json_to_file(
+        input_otio,
+        filepath,
+        indent,
+        max_threads
+    )
@@ -12,16 +12,23 @@ from .. _otio import ( # noqa
     Track,
 
     # functions
+    deserialize_binary_from_file,
+    deserialize_binary_from_string,
     deserialize_json_from_file,
     deserialize_json_from_string,
     flatten_stack,
     install_external_keepalive_monitor,
     instance_from_schema,
+    object_arena_enabled,
+    object_arena_live_blocks,
     register_serializable_object_type,
     register_upgrade_function,
+    set_object_arena_enabled,
     set_type_record,
     _serialize_json_to_string,
     _serialize_json_to_file,
+    _serialize_binary_to_string,
+    _serialize_binary_to_file,
 )
 
 from . _core_utils import ( # noqa
@@ -43,8 +50,25 @@ def serialize_json_to_string(root, indent=4):
     return _serialize_json_to_string(_value_to_any(root), indent)
 
 
-def serialize_json_to_file(root, filename, indent=4):
-    return _serialize_json_to_file(_value_to_any(root), filename, indent)
+def serialize_json_to_file(root, filename, indent=4, max_threads=1):
+    return _serialize_json_to_file(
+        _value_to_any(root),
+        filename,
+        indent,
+        max_threads
+    )
+
+
+def serialize_binary_to_string(root, object_offsets=False):
+    return _serialize_binary_to_string(_value_to_any(root), object_offsets)
+
+
+def serialize_binary_to_file(root, filename, object_offsets=False):
+    return _serialize_binary_to_file(
+        _value_to_any(root),
+        filename,
+        object_offsets
+    )
 
 
 def register_type(classobj, schemaname=None):
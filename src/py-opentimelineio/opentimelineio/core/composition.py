@@ -45,31 +45,8 @@ def child_at_time(
     If shallow_search is false, will recurse into compositions.
     """
 
-    range_map = self.range_of_all_children()
-
-    # find the first item whose end_time_exclusive is after the
-    first_inside_range = _bisect_left(
-        seq=self,
-        tgt=search_time,
-        key_func=lambda child: range_map[child].end_time_exclusive(),
-    )
-
-    # find the last item whose start_time is before the
-    last_in_range = _bisect_right(
-        seq=self,
-        tgt=search_time,
-        key_func=lambda child: range_map[child].start_time,
-        lower_search_bound=first_inside_range,
-    )
-
-    # limit the search to children who are in the search_range
-    possible_matches = self[first_inside_range:last_in_range]
-
-    result = None
-    for thing in possible_matches:
-        if range_map[thing].overlaps(search_time):
-            result = thing
-            break
+    matches = self.children_at_time(search_time, shallow_search=True)
+    result = matches[0] if matches else None
 
     # if the search cannot or should not continue
     if (
@@ -1,11 +1,15 @@
 from . _opentime import ( # noqa
     RationalTime,
     TimeRange,
+    TimeRangeArray,
     TimeTransform,
+    ExactTime,
+    ExactTimeRange,
 )
 
 from_frames = RationalTime.from_frames
 from_timecode = RationalTime.from_timecode
+from_timecodes = RationalTime.from_timecodes
 from_time_string = RationalTime.from_time_string
 from_seconds = RationalTime.from_seconds
 
@@ -25,6 +29,9 @@ def to_timecode(rt, rate=None, drop_frame=None):
     )
 
 
+to_timecodes = RationalTime.to_timecodes
+
+
 def to_frames(rt, rate=None):
     return rt.to_frames() if rate is None else rt.to_frames(rate)
 
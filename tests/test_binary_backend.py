@@ -0,0 +1,135 @@
+#
+# Copyright Contributors to the OpenTimelineIO project
+#
+# Licensed under the Apache License, Version 2.0 (the "Apache License")
+# with the following modification; you may not use this file except in
+# compliance with the Apache License and the following modification to it:
+# Section 6. Trademarks. is deleted and replaced with:
+#
+# 6. Trademarks. This License does not grant permission to use the trade
+#    names, trademarks, service marks, or product names of the Licensor
+#    and its affiliates, except as required to comply with Section 4(c) of
+#    the License and to reproduce the content of the NOTICE file.
+#
+# You may obtain a copy of the Apache License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the Apache License with the above modification is
+# distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied. See the Apache License for the specific
+# language governing permissions and limitations under the Apache License.
+#
+"""Unit tests for the binary format OTIO Serializes to."""
+
+import os
+import struct
+import unittest
+
+import opentimelineio as otio
+import opentimelineio.test_utils as otio_test_utils
+from opentimelineio.adapters import otio_binary
+
+# handle python2 vs python3 difference
+try:
+    from tempfile import TemporaryDirectory  # noqa: F401
+    import tempfile
+except ImportError:
+    # XXX: python2.7 only
+    from backports import tempfile
+
+
+class TestBinaryFormat(unittest.TestCase, otio_test_utils.OTIOAssertions):
+
+    def setUp(self):
+        self.maxDiff = None
+
+        self.tl = otio.schema.Timeline(name="test")
+        self.tl.metadata["foo"] = {
+            "bar": [1, -2, 3.5, None, True, "baz"],
+            "transform": otio.opentime.TimeTransform(
+                otio.opentime.RationalTime(1, 24),
+                scale=2
+            ),
+        }
+        track = otio.schema.Track(name="track")
+        self.tl.tracks.append(track)
+        for i in range(3):
+            track.append(
+                otio.schema.Clip(
+                    name="clip{}".format(i),
+                    media_reference=otio.schema.ExternalReference(
+                        target_url="clip{}.mov".format(i)
+                    ),
+                    source_range=otio.opentime.TimeRange(
+                        otio.opentime.RationalTime(i, 24),
+                        otio.opentime.RationalTime(10, 24)
+                    )
+                )
+            )
+        track.append(otio.schema.Gap())
+
+    def test_round_trip(self):
+        for object_offsets in (False, True):
+            encoded = otio_binary.write_to_string(
+                self.tl,
+                object_offsets
+            )
+            decoded = otio_binary.read_from_string(encoded)
+            self.assertIsOTIOEquivalentTo(decoded, self.tl)
+            self.assertEqual(
+                otio.adapters.otio_json.write_to_string(decoded),
+                otio.adapters.otio_json.write_to_string(self.tl)
+            )
+
+    def test_round_trip_file(self):
+        with tempfile.TemporaryDirectory(
+            prefix='test_round_trip_file'
+        ) as temp_dir:
+            temp_file = os.path.join(temp_dir, "test.otiob")
+            otio.adapters.write_to_file(self.tl, temp_file)
+            self.assertIsOTIOEquivalentTo(
+                otio.adapters.read_from_file(temp_file),
+                self.tl
+            )
+
+    def test_smaller_than_json(self):
+        self.assertLess(
+            len(otio_binary.write_to_string(self.tl)),
+            len(otio.adapters.otio_json.write_to_string(self.tl, -1))
+        )
+
+    def test_parse_error(self):
+        encoded = otio_binary.write_to_string(self.tl)
+
+        with self.assertRaises(ValueError):
+            otio_binary.read_from_string(b"not otio")
+
+        with self.assertRaises(ValueError):
+            otio_binary.read_from_string(encoded[:-1])
+
+    def test_nesting_limit(self):
+        def nested_lists(depth):
+            # the header, lists each holding the next, a null at the bottom,
+            # an empty string table and the offset of that
+            body = b"\x0b\x01" * depth + b"\x00"
+            return (
+                b"OTIOB\x01\x00" + body + b"\x00" +
+                struct.pack("<Q", 7 + len(body))
+            )
+
+        value = otio_binary.read_from_string(nested_lists(100))
+        for _ in range(100):
+            self.assertEqual(len(value), 1)
+            value = value[0]
+        self.assertIsNone(value)
+
+        # deeper than the reader recurses, rather than overflowing its stack
+        with self.assertRaises(ValueError) as context:
+            otio_binary.read_from_string(nested_lists(100000))
+        self.assertIn("nested too deeply", str(context.exception))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -34,6 +34,16 @@ SAMPLE_DATA_DIR = os.path.join(os.path.dirname(__file__), "sample_data")
 TRANSITION_EXAMPLE_PATH = os.path.join(SAMPLE_DATA_DIR, "transition_test.otio")
 
 
+def clip_lasting(name, duration):
+    """A clip lasting duration frames at 24 fps, starting from 0."""
+    return otio.schema.Clip(
+        name=name,
+        source_range=otio.opentime.TimeRange(
+            duration=otio.opentime.RationalTime(duration, 24)
+        )
+    )
+
+
 class CompositionTests(unittest.TestCase, otio_test_utils.OTIOAssertions):
 
     def test_cons(self):
@@ -1334,6 +1344,107 @@ class TrackTest(unittest.TestCase, otio_test_utils.OTIOAssertions):
             otio.opentime.RationalTime(150, 24)
         )
 
+    def test_transform_to_root(self):
+        def rt(value):
+            return otio.opentime.RationalTime(value, 24)
+
+        def make_clip(name, start, duration=50):
+            return otio.schema.Clip(
+                name=name,
+                source_range=otio.opentime.TimeRange(rt(start), rt(duration))
+            )
+
+        sq = otio.schema.Track(
+            children=[make_clip("clip1", 100), make_clip("clip2", 200)]
+        )
+        st = otio.schema.Stack(children=[sq])
+        clip1 = sq[0]
+        clip2 = sq[1]
+
+        def to_root(item, value):
+            return item.transform_to_root().applied_to(rt(value))
+
+        self.assertEqual(to_root(st, 10), rt(10))
+        self.assertEqual(to_root(clip1, 100), rt(0))
+        self.assertEqual(to_root(clip2, 200), rt(50))
+
+        # edits anywhere are picked up, however they're made
+        sq.insert(0, make_clip("clip0", 0))
+        self.assertEqual(to_root(clip2, 200), rt(100))
+
+        clip1.source_range = otio.opentime.TimeRange(rt(100), rt(20))
+        self.assertEqual(to_root(clip2, 200), rt(70))
+        self.assertEqual(clip2.transformed_time(rt(200), clip1), rt(120))
+
+        sq.source_range = otio.opentime.TimeRange(rt(30), rt(40))
+        self.assertEqual(to_root(clip2, 200), rt(40))
+
+        del sq[0]
+        self.assertEqual(to_root(clip2, 200), rt(-10))
+
+        # and so are edits further up, and to what media says is available
+        outer = otio.schema.Track(children=[make_clip("lead", 0, 10), st])
+        self.assertEqual(to_root(clip2, 200), rt(0))
+
+        outer[0].source_range = otio.opentime.TimeRange(rt(0), rt(15))
+        self.assertEqual(to_root(clip2, 200), rt(5))
+
+        media = otio.schema.ExternalReference(
+            available_range=otio.opentime.TimeRange(rt(0), rt(10))
+        )
+        sq.insert(0, otio.schema.Clip(name="media", media_reference=media))
+        self.assertEqual(to_root(clip2, 200), rt(15))
+
+        media.available_range = otio.opentime.TimeRange(rt(0), rt(30))
+        self.assertEqual(to_root(clip2, 200), rt(35))
+        self.assertEqual(clip2.transformed_time(rt(200), outer), rt(35))
+
+    def test_transformed_time_mixed_rates(self):
+        # The offsets are added up level by level, only as far up as needed,
+        # so that the result's rate is that of the time and the offsets
+        # passed on the way, not of the track's above the clip.
+        clip = otio.schema.Clip(
+            source_range=otio.opentime.TimeRange(
+                otio.opentime.RationalTime(10, 24),
+                otio.opentime.RationalTime(48, 24)
+            )
+        )
+        track = otio.schema.Track(
+            children=[clip],
+            source_range=otio.opentime.TimeRange(
+                otio.opentime.RationalTime(5, 30),
+                otio.opentime.RationalTime(30, 30)
+            )
+        )
+        stack = otio.schema.Stack(children=[track])
+
+        # the track's own trim is the one offset between it and the stack
+        self.assertIs(track.parent(), stack)
+        self.assertEqual(
+            track.transform_to_root().offset,
+            otio.opentime.RationalTime(-5, 30)
+        )
+
+        in_track = clip.transformed_time(
+            otio.opentime.RationalTime(20, 24),
+            track
+        )
+        self.assertEqual(in_track.rate, 24)
+        self.assertEqual(in_track.value, 10)
+
+        # the same by way of the transforms to the root, which sum offsets
+        # at the track's rate on the way, but give a time at the rate of the
+        # one they're applied to
+        via_root = otio.opentime.TimeTransform(
+            -track.transform_to_root().offset
+        ).applied_to(
+            clip.transform_to_root().applied_to(
+                otio.opentime.RationalTime(20, 24)
+            )
+        )
+        self.assertEqual(via_root.rate, 24)
+        self.assertEqual(via_root, in_track)
+
     def test_neighbors_of_simple(self):
         seq = otio.schema.Track()
         trans = otio.schema.Transition(
@@ -1452,6 +1563,155 @@ class TrackTest(unittest.TestCase, otio_test_utils.OTIOAssertions):
         track = otio.schema.Track()
         self.assertEqual(track.range_of_all_children(), {})
 
+    def test_track_range_array_of_children(self):
+        timeline = otio.adapters.read_from_file(TRANSITION_EXAMPLE_PATH)
+        track = timeline.tracks[0]
+
+        ranges = track.range_array_of_children(24)
+        self.assertEqual(len(ranges), len(track))
+        for index in range(len(track)):
+            self.assertEqual(
+                ranges[index],
+                track.range_of_child_at_index(index)
+            )
+
+        empty = otio.schema.Track().range_array_of_children(24)
+        self.assertEqual(len(empty), 0)
+
+    def test_range_of_child_after_edits(self):
+        def starts(track):
+            return [
+                track.range_of_child_at_index(i).start_time.value
+                for i in range(len(track))
+            ]
+
+        tr = otio.schema.Track()
+        for i in range(5):
+            tr.append(clip_lasting(str(i), 10))
+        self.assertEqual(starts(tr), [0, 10, 20, 30, 40])
+
+        tr.insert(1, clip_lasting("ins", 5))
+        self.assertEqual(starts(tr), [0, 10, 15, 25, 35, 45])
+
+        del tr[0]
+        self.assertEqual(starts(tr), [0, 5, 15, 25, 35])
+
+        tr[1] = clip_lasting("set", 2)
+        self.assertEqual(starts(tr), [0, 5, 7, 17, 27])
+
+        tr[0].source_range = otio.opentime.TimeRange(
+            duration=otio.opentime.RationalTime(1, 24)
+        )
+        self.assertEqual(starts(tr), [0, 1, 3, 13, 23])
+
+        ref = otio.schema.ExternalReference(
+            available_range=otio.opentime.TimeRange(
+                duration=otio.opentime.RationalTime(8, 24)
+            )
+        )
+        tr.insert(0, otio.schema.Clip(media_reference=ref))
+        self.assertEqual(starts(tr), [0, 8, 9, 11, 21, 31])
+
+        ref.available_range = otio.opentime.TimeRange(
+            duration=otio.opentime.RationalTime(4, 24)
+        )
+        self.assertEqual(starts(tr), [0, 4, 5, 7, 17, 27])
+
+        # edits to a nested track move the siblings that follow it
+        outer = otio.schema.Track()
+        inner = otio.schema.Track()
+        inner.append(clip_lasting("a", 10))
+        outer.append(inner)
+        outer.append(clip_lasting("b", 10))
+        self.assertEqual(starts(outer), [0, 10])
+        inner.append(clip_lasting("c", 4))
+        self.assertEqual(starts(outer), [0, 14])
+
+    def test_children_at_time(self):
+        def at(track, frame, shallow_search=True):
+            return [
+                c.name for c in track.children_at_time(
+                    otio.opentime.RationalTime(frame, 24),
+                    shallow_search=shallow_search
+                )
+            ]
+
+        tr = otio.schema.Track()
+        for i in range(100):
+            tr.append(clip_lasting(str(i), 10))
+
+        self.assertEqual(at(tr, -1), [])
+        self.assertEqual(at(tr, 0), ["0"])
+        self.assertEqual(at(tr, 9), ["0"])
+        self.assertEqual(at(tr, 10), ["1"])
+        self.assertEqual(at(tr, 555), ["55"])
+        self.assertEqual(at(tr, 999), ["99"])
+        self.assertEqual(at(tr, 1000), [])
+
+        self.assertEqual(
+            [
+                c.name for c in tr.children_in_range(
+                    otio.opentime.TimeRange(
+                        otio.opentime.RationalTime(15, 24),
+                        otio.opentime.RationalTime(20, 24)
+                    )
+                )
+            ],
+            ["1", "2", "3"]
+        )
+
+        # a transition belongs to the earlier child's range first
+        tr.insert(
+            1,
+            otio.schema.Transition(
+                name="t",
+                in_offset=otio.opentime.RationalTime(2, 24),
+                out_offset=otio.opentime.RationalTime(2, 24)
+            )
+        )
+        self.assertEqual(at(tr, 8), ["0"])
+        self.assertEqual(at(tr, 10), ["t"])
+        self.assertEqual(at(tr, 12), ["1"])
+
+        # a stack fans the search out to each of its tracks
+        st = otio.schema.Stack(children=[tr, otio.schema.Track()])
+        st[1].append(clip_lasting("other", 2000))
+        self.assertEqual(at(st, 25, shallow_search=False), ["", "2", "", "other"])
+        self.assertEqual(at(st, 1500, shallow_search=False), ["", "other"])
+        self.assertEqual(st.child_at_time(otio.opentime.RationalTime(25, 24)).name, "2")
+
+    def test_children_at_time_with_negative_duration(self):
+        # a negative duration pulls the children after it back in time, so
+        # the start times aren't sorted and can't be searched by bisection
+        tr = otio.schema.Track()
+        tr.append(clip_lasting("a", 10))
+        tr.append(clip_lasting("neg", -25))
+        for i in range(4):
+            tr.append(clip_lasting("b{}".format(i), 10))
+
+        def names(children):
+            return [c.name for c in children]
+
+        def at(frame):
+            return names(
+                tr.children_at_time(otio.opentime.RationalTime(frame, 24))
+            )
+
+        self.assertEqual(at(5), ["a"])
+        self.assertEqual(at(12), ["b2"])
+        self.assertEqual(at(-10), ["b0"])
+        self.assertEqual(
+            names(
+                tr.children_in_range(
+                    otio.opentime.TimeRange(
+                        otio.opentime.RationalTime(8, 24),
+                        otio.opentime.RationalTime(2, 24)
+                    )
+                )
+            ),
+            ["a", "b2"]
+        )
+
 
 class EdgeCases(unittest.TestCase):
 
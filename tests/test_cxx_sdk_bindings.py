@@ -31,6 +31,21 @@ class CxxSDKTests(unittest.TestCase):
     def test_cpp_big_ints(self):
         self.assertTrue(otio._otio._testing.test_big_uint())
 
+    def test_cpp_object_arena(self):
+        self.assertTrue(otio._otio._testing.test_object_arena())
+
+    def test_cpp_writer_value_types(self):
+        self.assertTrue(otio._otio._testing.test_writer_value_types())
+
+    def test_cpp_reference_ids(self):
+        self.assertTrue(otio._otio._testing.test_reference_ids())
+
+    def test_cpp_json_chunks(self):
+        self.assertTrue(otio._otio._testing.test_json_chunks())
+
+    def test_cpp_shared_metadata(self):
+        self.assertTrue(otio._otio._testing.test_shared_metadata())
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -157,6 +157,37 @@ class EditCommandTests(unittest.TestCase, otio_test_utils.OTIOAssertions):
                          Intersection.Type.IntersectBefore)
 
 
+    def test_intersections_across_undo(self):
+        Intersection = otio.edit.Intersection
+
+        for i in range(100):
+            self.track.append(self.new_clip("c{}".format(i)))
+
+        def names(start, dur):
+            return [
+                i.item.name for i in Intersection.get_intersections(
+                    self.track,
+                    track_range=self.tr(start, dur)
+                )
+            ]
+
+        self.assertEqual(names(505, 20), ["c50", "c51", "c52"])
+
+        # [ c50 ][ c51 ][ c52 ] -> [ c50 ][   o   ][ c52 ]
+        stack = otio.edit.overwrite(
+            otio.schema.Clip(name="o", source_range=self.tr(0, 10)),
+            self.track,
+            RationalTime(510, 24)
+        )
+        self.assertEqual(names(505, 20), ["c50", "o", "c52"])
+        self.assertEqual(names(995, 10), ["c99"])
+
+        stack.revert()
+        self.assertEqual(names(505, 20), ["c50", "c51", "c52"])
+
+        stack.run()
+        self.assertEqual(names(505, 20), ["c50", "o", "c52"])
+
     def test_overwrite(self):
         self.clip.source_range = self.tr(1, 25)
         self.assertEqual(self.clip.source_range.duration, RationalTime(25, 24))
@@ -24,6 +24,8 @@
 
 """Unit tests for the JSON format OTIO Serializes to."""
 
+import gzip
+import os
 import unittest
 import json
 
@@ -32,6 +34,35 @@ import opentimelineio.test_utils as otio_test_utils
 
 # local to test dir
 from tests import baseline_reader
+from tests.test_composition import clip_lasting
+
+# handle python2 vs python3 difference
+try:
+    from tempfile import TemporaryDirectory  # noqa: F401
+    import tempfile
+except ImportError:
+    # XXX: python2.7 only
+    from backports import tempfile
+
+
+def timeline_with_clips(name, clip_count):
+    """A timeline of two tracks, each of clip_count clips with metadata."""
+    tl = otio.schema.Timeline(name=name)
+    for t in range(2):
+        track = otio.schema.Track(name="track{}".format(t))
+        tl.tracks.append(track)
+        for i in range(clip_count):
+            track.append(
+                otio.schema.Clip(
+                    name="clip{}".format(i),
+                    metadata={"index": i, "tags": ["a", "b"]},
+                    source_range=otio.opentime.TimeRange(
+                        otio.opentime.RationalTime(i, 24),
+                        otio.opentime.RationalTime(10, 24)
+                    )
+                )
+            )
+    return tl
 
 
 class TestJsonFormat(unittest.TestCase, otio_test_utils.OTIOAssertions):
@@ -140,6 +171,390 @@ class TestJsonFormat(unittest.TestCase, otio_test_utils.OTIOAssertions):
         trx = otio.schema.GeneratorReference()
         self.check_against_baseline(trx, "empty_generator_reference")
 
+    def test_metadata_value_types(self):
+        # made by the bindings, whose type_infos may be aliases of the
+        # library's, so that the writer has to find them by name
+        rt = otio.opentime.RationalTime(5, 24)
+        metadata = {
+            "none": None,
+            "bool": True,
+            "int": 1 << 40,
+            "float": 0.25,
+            "string": "string",
+            "rational_time": rt,
+            "time_range": otio.opentime.TimeRange(rt, rt),
+            "time_transform": otio.opentime.TimeTransform(rt, 2, 30),
+            "object": otio.schema.Marker(name="marker"),
+            "dict": {"key": [1, "2"]},
+            "list": [{"key": 1}, 2.5],
+        }
+        so = otio.core.SerializableObjectWithMetadata(metadata=metadata)
+
+        decoded = otio.adapters.otio_json.read_from_string(
+            otio.adapters.otio_json.write_to_string(so)
+        )
+        self.assertIsOTIOEquivalentTo(decoded, so)
+        for key, value in metadata.items():
+            if key not in ("object", "dict", "list"):
+                self.assertEqual(decoded.metadata[key], value)
+        self.assertEqual(decoded.metadata["object"].name, "marker")
+        self.assertEqual(list(decoded.metadata["dict"]["key"]), [1, "2"])
+        self.assertEqual(dict(decoded.metadata["list"][0]), {"key": 1})
+        self.assertEqual(decoded.metadata["list"][1], 2.5)
+
+    def test_read_from_file(self):
+        tl = otio.schema.Timeline(name="test")
+        tl.tracks.append(otio.schema.Track(name="track"))
+
+        with tempfile.TemporaryDirectory(
+            prefix='test_read_from_file'
+        ) as temp_dir:
+            temp_file = os.path.join(temp_dir, "test.otio")
+            otio.adapters.otio_json.write_to_file(tl, temp_file)
+            self.assertJsonEqual(
+                otio.adapters.otio_json.read_from_file(temp_file),
+                tl
+            )
+
+            empty_file = os.path.join(temp_dir, "empty.otio")
+            open(empty_file, "w").close()
+            with self.assertRaises(ValueError):
+                otio.adapters.otio_json.read_from_file(empty_file)
+
+    def test_read_from_file_lazily(self):
+        tl = otio.schema.Timeline(name="test")
+        tl.metadata["foo"] = {"bar": [1, 2, 3]}
+        track = otio.schema.Track(name="track", metadata={"baz": "qux"})
+        tl.tracks.append(track)
+        for i in range(3):
+            track.append(
+                otio.schema.Clip(
+                    name="clip{}".format(i),
+                    source_range=otio.opentime.TimeRange(
+                        otio.opentime.RationalTime(0, 24),
+                        otio.opentime.RationalTime(10, 24)
+                    )
+                )
+            )
+
+        with tempfile.TemporaryDirectory(
+            prefix='test_read_from_file_lazily'
+        ) as temp_dir:
+            temp_file = os.path.join(temp_dir, "test.otio")
+            otio.adapters.otio_json.write_to_file(tl, temp_file)
+            result = otio.adapters.otio_json.read_from_file(
+                temp_file,
+                lazy=True
+            )
+            self.assertEqual(list(result.metadata["foo"]["bar"]), [1, 2, 3])
+            self.assertEqual(result.tracks[0].metadata["baz"], "qux")
+            self.assertEqual(
+                result.tracks[0].range_of_child_at_index(2),
+                track.range_of_child_at_index(2)
+            )
+            self.assertJsonEqual(result, tl)
+
+    def test_search_lazily_read_track(self):
+        track = otio.schema.Track(name="track")
+        for i in range(4):
+            track.append(clip_lasting("clip{}".format(i), 10))
+        track.append(
+            otio.schema.Stack(name="stack", children=[clip_lasting("inner", 7)])
+        )
+        track.append(clip_lasting("last", 10))
+
+        at = otio.opentime.RationalTime(52, 24)
+        in_range = otio.opentime.TimeRange(
+            otio.opentime.RationalTime(35, 24),
+            otio.opentime.RationalTime(10, 24)
+        )
+
+        with tempfile.TemporaryDirectory(
+            prefix='test_search_lazily_read_track'
+        ) as temp_dir:
+            temp_file = os.path.join(temp_dir, "test.otio")
+            otio.adapters.otio_json.write_to_file(track, temp_file)
+
+            def read():
+                return otio.adapters.otio_json.read_from_file(
+                    temp_file,
+                    lazy=True
+                )
+
+            # each from a fresh read, so that each is what finishes decoding
+            # the track and the stack within it
+            self.assertEqual(
+                [c.name for c in read().children_at_time(at)],
+                ["last"]
+            )
+            self.assertEqual(
+                [
+                    c.name for c in read().children_in_range(
+                        in_range,
+                        shallow_search=False
+                    )
+                ],
+                ["clip3", "stack", "inner"]
+            )
+            self.assertEqual(read().child_at_time(at).name, "last")
+            self.assertEqual(
+                read().range_of_child_at_index(5).start_time,
+                otio.opentime.RationalTime(47, 24)
+            )
+
+    def test_lazily_read_values_that_fail_to_decode(self):
+        track = json.loads(
+            otio.adapters.otio_json.write_to_string(
+                otio.schema.Track(name="track", metadata={"foo": "bar"})
+            )
+        )
+        broken_children = dict(track, children=[{"OTIO_SCHEMA": "Gap.1"}, 5])
+        broken_metadata = dict(
+            track,
+            metadata={
+                "at": {"OTIO_SCHEMA": "RationalTime.1", "rate": "x", "value": 1}
+            }
+        )
+
+        with tempfile.TemporaryDirectory(
+            prefix='test_lazily_read_values_that_fail_to_decode'
+        ) as temp_dir:
+            temp_file = os.path.join(temp_dir, "test.otio")
+            for broken in (broken_children, broken_metadata):
+                with open(temp_file, "w") as f:
+                    json.dump(broken, f)
+
+                # too late to fail the read, but what couldn't be decoded
+                # mustn't be quietly left out of what's written
+                result = otio.adapters.otio_json.read_from_file(
+                    temp_file,
+                    lazy=True
+                )
+                self.assertEqual(result.name, "track")
+                with self.assertRaises(ValueError):
+                    otio.adapters.otio_json.write_to_string(result)
+                with self.assertRaises(ValueError):
+                    result.clone()
+
+    def test_write_large_file(self):
+        # several times the size of the chunks the writer hands on
+        track = otio.schema.Track(name="track")
+        for i in range(2000):
+            track.append(
+                otio.schema.Clip(
+                    name="clip{}".format(i),
+                    source_range=otio.opentime.TimeRange(
+                        otio.opentime.RationalTime(i, 24),
+                        otio.opentime.RationalTime(10, 24)
+                    )
+                )
+            )
+        expected = otio.adapters.otio_json.write_to_string(track)
+        self.assertGreater(len(expected), 4 * 65536)
+
+        with tempfile.TemporaryDirectory(
+            prefix='test_write_large_file'
+        ) as temp_dir:
+            temp_file = os.path.join(temp_dir, "test.otio")
+            otio.adapters.otio_json.write_to_file(track, temp_file)
+            with open(temp_file, "r") as f:
+                self.assertEqual(f.read(), expected)
+            self.assertJsonEqual(
+                otio.adapters.otio_json.read_from_file(temp_file),
+                track
+            )
+
+    def test_write_to_unwritable_file(self):
+        tl = otio.schema.Timeline(name="test")
+
+        with tempfile.TemporaryDirectory(
+            prefix='test_write_to_unwritable_file'
+        ) as temp_dir:
+            # can't be opened
+            missing_dir_file = os.path.join(temp_dir, "missing", "test.otio")
+            with self.assertRaises(ValueError) as context:
+                otio.adapters.otio_json.write_to_file(tl, missing_dir_file)
+            self.assertIn(
+                "failed to open file for writing",
+                str(context.exception)
+            )
+
+        # opens, but nothing written to it gets anywhere
+        if os.path.exists("/dev/full"):
+            with self.assertRaises(ValueError) as context:
+                otio.adapters.otio_json.write_to_file(tl, "/dev/full")
+            self.assertIn(
+                "failed to open file for writing",
+                str(context.exception)
+            )
+
+    def test_write_to_file_in_parallel(self):
+        # the timelines of the collection, and the clips of each track, are
+        # enough to be split between the threads; a stack's two tracks aren't
+        collection = otio.schema.SerializableCollection(
+            name="collection",
+            children=[
+                timeline_with_clips("tl{}".format(i), 50) for i in range(6)
+            ]
+        )
+
+        with tempfile.TemporaryDirectory(
+            prefix='test_write_to_file_in_parallel'
+        ) as temp_dir:
+            for root in (collection, collection[0], collection[0].tracks[0]):
+                for indent in (4, -1):
+                    contents = []
+                    for max_threads in (1, 4, 0):
+                        temp_file = os.path.join(
+                            temp_dir,
+                            "test{}.otio".format(max_threads)
+                        )
+                        otio.adapters.otio_json.write_to_file(
+                            root,
+                            temp_file,
+                            indent=indent,
+                            max_threads=max_threads
+                        )
+                        with open(temp_file, "rb") as f:
+                            contents.append(f.read())
+
+                    self.assertEqual(contents[1], contents[0])
+                    self.assertEqual(contents[2], contents[0])
+                    self.assertEqual(
+                        contents[0].decode("utf-8"),
+                        otio.adapters.otio_json.write_to_string(root, indent)
+                    )
+
+    def test_read_from_file_in_parallel(self):
+        collection = otio.schema.SerializableCollection(
+            name="collection",
+            children=[
+                timeline_with_clips("tl{}".format(i), 10) for i in range(6)
+            ]
+        )
+        encoded = otio.adapters.otio_json.write_to_string(collection)
+
+        with tempfile.TemporaryDirectory(
+            prefix='test_read_from_file_in_parallel'
+        ) as temp_dir:
+            temp_file = os.path.join(temp_dir, "test.otio")
+            with open(temp_file, "w") as f:
+                f.write(encoded)
+
+            serial = otio.adapters.otio_json.read_from_file(temp_file)
+            self.assertJsonEqual(serial, collection)
+            for max_threads in (4, 0):
+                for lazy in (False, True):
+                    self.assertJsonEqual(
+                        otio.adapters.otio_json.read_from_file(
+                            temp_file,
+                            lazy=lazy,
+                            max_threads=max_threads
+                        ),
+                        serial
+                    )
+
+            # whether in one of the children, decoded on threads of their
+            # own, or in the rest of the root, an error is reported just as
+            # a serial read reports it; the rest of the root is decoded from
+            # a copy without the children, so the error there goes after them
+            in_child = encoded.replace('"name": "tl3"', '"name": tl3')
+            in_root = encoded.replace('    "name": "collection",\n', '')
+            in_root = (
+                in_root[:in_root.rindex("}")].rstrip() +
+                ',\n    "name": collection\n}'
+            )
+            for bad in (in_child, in_root):
+                self.assertNotEqual(bad, encoded)
+                with open(temp_file, "w") as f:
+                    f.write(bad)
+
+                errors = []
+                for max_threads in (1, 4, 0):
+                    with self.assertRaises(ValueError) as context:
+                        otio.adapters.otio_json.read_from_file(
+                            temp_file,
+                            max_threads=max_threads
+                        )
+                    errors.append(str(context.exception))
+                self.assertIn("(line ", errors[0])
+                self.assertEqual(errors[1], errors[0])
+                self.assertEqual(errors[2], errors[0])
+
+    def test_read_compressed_file(self):
+        tl = otio.schema.Timeline(name="test")
+        tl.tracks.append(otio.schema.Track(name="track"))
+
+        with tempfile.TemporaryDirectory(
+            prefix='test_read_compressed_file'
+        ) as temp_dir:
+            # recognized by its contents, whatever it is called
+            temp_file = os.path.join(temp_dir, "test.otio")
+            with gzip.open(temp_file, "wb") as f:
+                f.write(
+                    otio.adapters.otio_json.write_to_string(tl).encode("utf-8")
+                )
+
+            try:
+                result = otio.adapters.otio_json.read_from_file(temp_file)
+            except NotImplementedError:
+                self.skipTest("built without gzip support")
+            self.assertJsonEqual(result, tl)
+
+            compressed_file = os.path.join(temp_dir, "test.otio.gz")
+            otio.adapters.otio_json.write_to_file(tl, compressed_file)
+            with gzip.open(compressed_file, "rb") as f:
+                self.assertJsonEqual(
+                    otio.adapters.otio_json.read_from_string(
+                        f.read().decode("utf-8")
+                    ),
+                    tl
+                )
+            self.assertJsonEqual(
+                otio.adapters.otio_json.read_from_file(compressed_file),
+                tl
+            )
+
+            with open(temp_file, "rb") as f:
+                truncated = f.read()[:-8]
+            with open(temp_file, "wb") as f:
+                f.write(truncated)
+            with self.assertRaises(ValueError):
+                otio.adapters.otio_json.read_from_file(temp_file)
+
+    def test_read_concatenated_gzip_file(self):
+        track = otio.schema.Track(name="track")
+        for i in range(500):
+            track.append(otio.schema.Clip(name="clip{}".format(i)))
+        encoded = otio.adapters.otio_json.write_to_string(track).encode("utf-8")
+
+        with tempfile.TemporaryDirectory(
+            prefix='test_read_concatenated_gzip_file'
+        ) as temp_dir:
+            # the size recorded at the end is only that of the little last
+            # member, far less than the whole
+            temp_file = os.path.join(temp_dir, "test.otio")
+            with open(temp_file, "wb") as f:
+                for member in (encoded[:-10], encoded[-10:]):
+                    with gzip.GzipFile(fileobj=f, mode="wb") as g:
+                        g.write(member)
+
+            try:
+                result = otio.adapters.otio_json.read_from_file(temp_file)
+            except NotImplementedError:
+                self.skipTest("built without gzip support")
+            self.assertJsonEqual(result, track)
+
+            with open(temp_file, "ab") as f:
+                f.write(b"not gzip")
+            with self.assertRaises(ValueError):
+                otio.adapters.otio_json.read_from_file(temp_file)
+
+    def test_parse_error_position(self):
+        with self.assertRaises(ValueError) as context:
+            otio.adapters.otio_json.read_from_string('{\n"a": 1,\n  "b": x}')
+        self.assertIn("(line 3, column 7)", str(context.exception))
+
 
 if __name__ == '__main__':
     unittest.main()
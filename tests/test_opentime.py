@@ -114,6 +114,53 @@ class TestTime(unittest.TestCase):
         t = otio.opentime.from_timecode(timecode, 24)
         self.assertEqual(timecode, otio.opentime.to_timecode(t))
 
+    def test_timecodes_in_bulk(self):
+        for rate in (24, 25, 29.97, 30000 / 1001.0, 59.94):
+            times = [
+                otio.opentime.RationalTime(value, rate)
+                for value in range(0, 200000, 997)
+            ]
+            timecodes = otio.opentime.to_timecodes(times, rate)
+            self.assertEqual(
+                timecodes,
+                [otio.opentime.to_timecode(t, rate) for t in times]
+            )
+            self.assertEqual(
+                otio.opentime.from_timecodes(timecodes, rate),
+                [otio.opentime.from_timecode(tc, rate) for tc in timecodes]
+            )
+
+        self.assertEqual(
+            otio.opentime.to_timecodes(
+                [otio.opentime.RationalTime(1800, 29.97)], 29.97, False
+            ),
+            ["00:01:00:00"]
+        )
+
+        with self.assertRaises(ValueError) as exception_manager:
+            otio.opentime.from_timecodes(
+                ['01:00:13:23', '01:00:13:24'],
+                24
+            )
+        self.assertEqual(
+            str(exception_manager.exception),
+            "Frame rate mismatch.  Timecode '01:00:13:24' has frames beyond 23",
+        )
+
+        with self.assertRaises(ValueError):
+            otio.opentime.to_timecodes(
+                [otio.opentime.RationalTime(-1, 24)],
+                24
+            )
+
+        # rates no timecode has, however far out, fail before any math
+        for rate in (float("nan"), float("inf"), 1e300, -24):
+            with self.assertRaises(ValueError):
+                otio.opentime.to_timecodes(
+                    [otio.opentime.RationalTime(1, 24)],
+                    rate
+                )
+
     def test_time_timecode_convert_bad_rate(self):
         with self.assertRaises(ValueError) as exception_manager:
             otio.opentime.from_timecode('01:00:13:24', 24)
@@ -1275,5 +1322,174 @@ class TestTimeRange(unittest.TestCase):
         self.assertNotEqual(frame, otio.opentime.to_frames(t, 12))
 
 
+class TestTimeRangeArray(unittest.TestCase):
+
+    def setUp(self):
+        self.ranges = [
+            otio.opentime.TimeRange(
+                otio.opentime.RationalTime(start, 24),
+                otio.opentime.RationalTime(duration, 24)
+            )
+            for start in (0, 10, 11.5, 20, 33)
+            for duration in (0, 1, 10, 23.75)
+        ]
+        self.array = otio.opentime.TimeRangeArray(self.ranges, 24)
+
+    def test_ranges(self):
+        self.assertEqual(len(self.array), len(self.ranges))
+        self.assertEqual(self.array.rate, 24)
+        self.assertEqual(list(self.array), self.ranges)
+        self.assertEqual(self.array[-1], self.ranges[-1])
+
+        with self.assertRaises(IndexError):
+            self.array[len(self.ranges)]
+
+        # ranges at other rates are rescaled as they are added
+        self.array.append(
+            otio.opentime.TimeRange(
+                otio.opentime.RationalTime(1, 2),
+                otio.opentime.RationalTime(1, 1)
+            )
+        )
+        self.assertEqual(self.array.start_values[-1], 12)
+        self.assertEqual(self.array.duration_values[-1], 24)
+
+    def test_relations_match_time_range(self):
+        others = [
+            otio.opentime.TimeRange(
+                otio.opentime.RationalTime(start, rate),
+                otio.opentime.RationalTime(duration, rate)
+            )
+            for start, duration, rate in (
+                (10, 10, 24), (11.5, 0, 24), (5, 30, 25), (20, 13, 48)
+            )
+        ]
+        for other in others:
+            time = other.start_time
+            self.assertEqual(
+                self.array.contains(time),
+                [r.contains(time) for r in self.ranges]
+            )
+            self.assertEqual(
+                self.array.overlaps(time),
+                [r.overlaps(time) for r in self.ranges]
+            )
+            for name in ("contains", "overlaps", "intersects"):
+                self.assertEqual(
+                    getattr(self.array, name)(other),
+                    [getattr(r, name)(other) for r in self.ranges]
+                )
+                self.assertEqual(
+                    getattr(self.array, name)(other, 0.5),
+                    [getattr(r, name)(other, 0.5) for r in self.ranges]
+                )
+
+            window = otio.opentime.TimeRange(
+                other.start_time.rescaled_to(24),
+                other.duration.rescaled_to(24)
+            )
+            self.assertEqual(
+                list(self.array.clamped_by(other)),
+                [window.clamped(r) for r in self.ranges]
+            )
+
+    def test_extent(self):
+        extent = self.ranges[0]
+        for r in self.ranges[1:]:
+            extent = extent.extended_by(r)
+        self.assertEqual(self.array.extent(), extent)
+
+        self.assertEqual(
+            otio.opentime.TimeRangeArray([], 24).extent(),
+            otio.opentime.TimeRange(otio.opentime.RationalTime(0, 24))
+        )
+
+
+class TestExactTime(unittest.TestCase):
+
+    def test_from_rational_time(self):
+        t = otio.opentime.ExactTime.from_rational_time(
+            otio.opentime.RationalTime(1, 30000 / 1001.0)
+        )
+        self.assertEqual(t.value, 1)
+        self.assertEqual(t.rate_numerator, 30000)
+        self.assertEqual(t.rate_denominator, 1001)
+        self.assertEqual(
+            t.to_rational_time(),
+            otio.opentime.RationalTime(1, 30000 / 1001.0)
+        )
+
+        # a fractional value moves to a rate that makes it whole
+        t = otio.opentime.ExactTime.from_rational_time(
+            otio.opentime.RationalTime(1.5, 24)
+        )
+        self.assertEqual((t.value, t.rate_numerator), (3, 48))
+
+        with self.assertRaises(ValueError):
+            otio.opentime.ExactTime.from_rational_time(
+                otio.opentime.RationalTime(1e-20, 24)
+            )
+
+    def test_exact_arithmetic(self):
+        frame = otio.opentime.ExactTime(1, 24000, 1001)
+        total = otio.opentime.ExactTime(0, 24000, 1001)
+        for _ in range(100000):
+            total += frame
+        self.assertEqual(
+            total,
+            otio.opentime.ExactTime(100000, 24000, 1001)
+        )
+        self.assertEqual(
+            total - frame,
+            otio.opentime.ExactTime(99999, 48000, 2002)
+        )
+
+        # across rates, results are at a rate both are whole numbers at
+        mixed = otio.opentime.ExactTime(1, 24) + frame
+        self.assertEqual((mixed.value, mixed.rate_numerator), (2001, 24000))
+        self.assertTrue(
+            otio.opentime.ExactTime(1, 25) < otio.opentime.ExactTime(1, 24)
+        )
+        self.assertEqual(
+            otio.opentime.ExactTime(2, 48),
+            otio.opentime.ExactTime(1, 24)
+        )
+
+        self.assertTrue(otio.opentime.ExactTime(1, 0).is_invalid_time())
+
+    def test_exact_range_predicates(self):
+        tr = otio.opentime.ExactTimeRange(
+            otio.opentime.ExactTime(12, 25),
+            otio.opentime.ExactTime(3, 25)
+        )
+        after = otio.opentime.ExactTimeRange(
+            otio.opentime.ExactTime(15, 25),
+            otio.opentime.ExactTime(3, 25)
+        )
+        self.assertTrue(tr.contains(otio.opentime.ExactTime(12, 25)))
+        self.assertFalse(tr.contains(otio.opentime.ExactTime(15, 25)))
+        self.assertFalse(tr.contains(tr))
+        self.assertTrue(tr.meets(after))
+        self.assertFalse(after.meets(tr))
+        self.assertFalse(tr.overlaps(after))
+        self.assertFalse(tr.intersects(after))
+        self.assertTrue(tr.overlaps(
+            otio.opentime.ExactTimeRange(
+                otio.opentime.ExactTime(26, 50),
+                otio.opentime.ExactTime(6, 50)
+            )
+        ))
+
+        time_range = otio.opentime.TimeRange(
+            otio.opentime.RationalTime(12, 25),
+            otio.opentime.RationalTime(3, 25)
+        )
+        self.assertEqual(
+            otio.opentime.ExactTimeRange.from_time_range(time_range),
+            tr
+        )
+        self.assertEqual(tr.to_time_range(), time_range)
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -48,6 +48,28 @@ class OpenTimeTypeSerializerTest(unittest.TestCase):
         decoded = otio.adapters.otio_json.read_from_string(encoded)
         self.assertEqual(tt, decoded)
 
+    def test_deserialize_time_any_key_order(self):
+        rt = otio.opentime.RationalTime(15, 24)
+        decoded = otio.adapters.otio_json.read_from_string(
+            '{"value": 15, "OTIO_SCHEMA": "RationalTime.1", "rate": 24}'
+        )
+        self.assertEqual(rt, decoded)
+
+        tr = otio.opentime.TimeRange(rt, otio.opentime.RationalTime(10, 24))
+        decoded = otio.adapters.otio_json.read_from_string(
+            '{"duration": {"OTIO_SCHEMA": "RationalTime.1",'
+            ' "rate": 24, "value": 10},'
+            ' "OTIO_SCHEMA": "TimeRange.1", "extra": 1,'
+            ' "start_time": {"rate": 24, "value": 15,'
+            ' "OTIO_SCHEMA": "RationalTime.1"}}'
+        )
+        self.assertEqual(tr, decoded)
+
+        with self.assertRaises(ValueError):
+            otio.adapters.otio_json.read_from_string(
+                '{"OTIO_SCHEMA": "RationalTime.1", "rate": 24}'
+            )
+
 
 class SerializableObjTest(unittest.TestCase, otio_test_utils.OTIOAssertions):
     def test_cons(self):
@@ -98,6 +120,34 @@ class SerializableObjTest(unittest.TestCase, otio_test_utils.OTIOAssertions):
 
         self.assertEqual(Foo, type(foo_copy))
 
+    def test_clone_mixed_types(self):
+        @otio.core.register_type
+        class Widget(otio.core.SerializableObjectWithMetadata):
+            _serializable_label = "Widget.1"
+            parts = otio.core.serializable_field("parts", doc="test")
+
+        widget = Widget()
+        widget.parts = [1, "two"]
+
+        track = otio.schema.Track(name="track")
+        clip = otio.schema.Clip(
+            name="clip",
+            source_range=otio.opentime.TimeRange(
+                otio.opentime.RationalTime(0, 24),
+                otio.opentime.RationalTime(10, 24)
+            )
+        )
+        clip.metadata["widget"] = widget
+        track.append(clip)
+        track.append(otio.schema.Gap())
+
+        track_copy = track.clone()
+        self.assertIsOTIOEquivalentTo(track, track_copy)
+        self.assertIsNot(track_copy[0], clip)
+        self.assertIs(track_copy[0].parent(), track_copy)
+        self.assertEqual(Widget, type(track_copy[0].metadata["widget"]))
+        self.assertEqual(track_copy[0].metadata["widget"].parts, [1, "two"])
+
     def test_schema_versioning(self):
         @otio.core.register_type
         class FakeThing(otio.core.SerializableObject):
@@ -169,6 +219,29 @@ class SerializableObjTest(unittest.TestCase, otio_test_utils.OTIOAssertions):
         A.metadata["key"]["sub-key"] = 1
         test_difference(A, B, "Add dict within A with specific metadata")
 
+    def test_large_metadata(self):
+        so = otio.core.SerializableObjectWithMetadata()
+        keys = ["key{}".format(i) for i in range(100)]
+        for i, key in enumerate(reversed(keys)):
+            so.metadata[key] = i
+        for key in keys[::3]:
+            del so.metadata[key]
+        so.metadata["key50"] = "replaced"
+
+        expected = sorted(k for k in keys if k not in keys[::3])
+        self.assertEqual(list(so.metadata.keys()), expected)
+        self.assertEqual(so.metadata["key50"], "replaced")
+        self.assertEqual(so.metadata["key1"], 98)
+        self.assertNotIn("key0", so.metadata)
+
+        encoded = otio.adapters.otio_json.write_to_string(so)
+        decoded = otio.adapters.otio_json.read_from_string(encoded)
+        self.assertIsOTIOEquivalentTo(so, decoded)
+
+        with self.assertRaises(ValueError):
+            for key in so.metadata:
+                so.metadata[key + "_copy"] = 1
+
     def test_truthiness(self):
         o = otio.core.SerializableObject()
         self.assertTrue(o)
@@ -185,6 +258,92 @@ class SerializableObjTest(unittest.TestCase, otio_test_utils.OTIOAssertions):
         # then this will (and should) fail
         self.assertTrue(oCopy.metadata["child1"] is not oCopy.metadata["child2"])
 
+    def test_object_arena(self):
+        track = otio.schema.Track(name="track", metadata={"foo": "bar"})
+        for i in range(100):
+            track.append(otio.schema.Gap(name="gap{}".format(i)))
+        encoded = otio.adapters.otio_json.write_to_string(track)
+
+        self.assertFalse(otio.core.object_arena_enabled())
+        otio.core.set_object_arena_enabled(True)
+        try:
+            self.assertTrue(otio.core.object_arena_enabled())
+            blocks = otio.core.object_arena_live_blocks()
+            in_use = []
+            for _ in range(3):
+                decoded = otio.adapters.otio_json.read_from_string(encoded)
+                copy = decoded.clone()
+                del decoded
+                in_use.append(otio.core.object_arena_live_blocks() - blocks)
+                self.assertIsOTIOEquivalentTo(copy, track)
+                self.assertEqual(copy[99].name, "gap99")
+                del copy
+
+                # each pass gives back all the blocks it took, for the next
+                # to reuse the memory of
+                self.assertEqual(otio.core.object_arena_live_blocks(), blocks)
+
+            self.assertGreater(in_use[0], 0)
+            self.assertEqual(in_use, [in_use[0]] * 3)
+        finally:
+            otio.core.set_object_arena_enabled(False)
+
+    def test_clone_sharing_metadata(self):
+        clip = otio.schema.Clip(name="clip", metadata={"foo": {"bar": 1}})
+        marker = otio.schema.Marker(name="marker")
+        clip.markers.append(marker)
+        clip.metadata["marker"] = marker
+
+        clip_copy = clip.clone(share_metadata=True)
+        self.assertIsOTIOEquivalentTo(clip, clip_copy)
+        self.assertIsNot(clip_copy.metadata["marker"], marker)
+
+        clip_copy.metadata["foo"]["bar"] = 2
+        self.assertEqual(clip.metadata["foo"]["bar"], 1)
+        clip.metadata["foo"]["bar"] = 3
+        self.assertEqual(clip_copy.metadata["foo"]["bar"], 2)
+
+    def test_clone_sharing_metadata_after_edits(self):
+        clip = otio.schema.Clip(name="clip", metadata={"foo": {"bar": 1}})
+        metadata = clip.metadata
+        first = clip.clone(share_metadata=True)
+
+        # through a proxy held from before the first clone, and a fresh one
+        metadata["foo"]["bar"] = 2
+        clip.metadata["baz"] = 3
+        second = clip.clone(share_metadata=True)
+        third = second.clone(share_metadata=True)
+
+        self.assertEqual(first.metadata["foo"]["bar"], 1)
+        self.assertNotIn("baz", first.metadata)
+        for copy in (second, third):
+            self.assertEqual(copy.metadata["foo"]["bar"], 2)
+            self.assertEqual(copy.metadata["baz"], 3)
+
+    def test_clone_sharing_metadata_between_siblings(self):
+        clip = otio.schema.Clip(name="clip", metadata={"foo": {"bar": 1}})
+        metadata = clip.metadata
+        first = clip.clone(share_metadata=True)
+        second = clip.clone(share_metadata=True)
+
+        # reading leaves the metadata shared (test_cpp_shared_metadata checks
+        # the storage itself), and a proxy held from before the clones still
+        # reads it
+        for so in (clip, first, second):
+            self.assertEqual(sorted(so.metadata), ["foo"])
+            self.assertEqual(len(so.metadata), 1)
+        self.assertEqual(metadata["foo"]["bar"], 1)
+
+        # writing, even to something nested, only changes the one written to
+        first.metadata["foo"]["bar"] = 2
+        metadata["baz"] = 3
+        self.assertEqual(first.metadata["foo"]["bar"], 2)
+        self.assertNotIn("baz", first.metadata)
+        self.assertEqual(clip.metadata["foo"]["bar"], 1)
+        self.assertEqual(clip.metadata["baz"], 3)
+        self.assertEqual(second.metadata["foo"]["bar"], 1)
+        self.assertNotIn("baz", second.metadata)
+
     def test_cycle_detection(self):
         o = otio.core.SerializableObjectWithMetadata()
         o.metadata["myself"] = o
@@ -195,6 +354,45 @@ class SerializableObjTest(unittest.TestCase, otio_test_utils.OTIOAssertions):
         #   self.assertTrue(oCopy is oCopy.metadata["myself"])
         with self.assertRaises(ValueError):
             o.clone()
+        with self.assertRaises(ValueError):
+            otio.adapters.otio_json.write_to_string(o)
+
+    def test_read_object_references(self):
+        # references may point either forwards or backwards in the file
+        encoded = """{
+            "OTIO_SCHEMA": "SerializableObjectWithMetadata.1",
+            "name": "root",
+            "metadata": {
+                "forward": {
+                    "OTIO_SCHEMA": "SerializableObjectRef.1",
+                    "id": "b"
+                },
+                "a": {
+                    "OTIO_SCHEMA": "SerializableObjectWithMetadata.1",
+                    "OTIO_REF_ID": "a",
+                    "name": "a",
+                    "metadata": {}
+                },
+                "b": {
+                    "OTIO_SCHEMA": "SerializableObjectWithMetadata.1",
+                    "OTIO_REF_ID": "b",
+                    "name": "b",
+                    "metadata": {
+                        "back": {
+                            "OTIO_SCHEMA": "SerializableObjectRef.1",
+                            "id": "a"
+                        }
+                    }
+                }
+            }
+        }"""
+        decoded = otio.adapters.otio_json.read_from_string(encoded)
+        a = decoded.metadata["a"]
+        b = decoded.metadata["b"]
+        self.assertEqual(a.name, "a")
+        self.assertEqual(b.name, "b")
+        self.assertTrue(decoded.metadata["forward"] is b)
+        self.assertTrue(b.metadata["back"] is a)
 
 
 if __name__ == '__main__':